@@ -1,579 +1,1791 @@
-#!/usr/bin/python
-
-import sys
-import re
-import os
-
-#import hotshot
-#prof = hotshot.Profile('816-opt.prof')
-#prof.start()
-
-verbose = True
-if os.getenv('OPT816_QUIET'): verbose = False
-
-# open the assembler file and put lines in array text
-text_raw = open(sys.argv[1],'r').readlines()
-text = []
-for l in text_raw:
-  if not l.startswith(';'): text += [l.strip()]
-
-# find .bss section symbols
-bss = []
-bsson = False
-for l in text:
-  if l == '.ramsection ".bss" bank $7e slot 2':
-    bsson = True
-    continue
-  if l == '.ends':
-    bsson = False
-  if bsson:
-    bss += [l.split(' ')[0]]
-#print 'bss',bss
-
-# checks if the line alters the control flow
-def is_control(line):
-  if len(line) > 0 and line[0] in 'jb+-' or line.endswith(':'): return True
-  return False
-
-def changes_accu(line):
-  if (line[2] == 'a' and not line[:3] in ['pha','sta']) or (len(line) == 5 and line.endswith(' a')): return True
-  else: return False
-
-totalopt = 0	# total number of optimizations performed
-opted = -1	# have we optimized in this pass?
-opass = 0	# optimization pass counter
-storetopseudo = re.compile('st([axyz]).b tcc__([rf][0-9]*h?)$')
-storexytopseudo = re.compile('st([xy]).b tcc__([rf][0-9]*h?)$')
-storeatopseudo = re.compile('sta.b tcc__([rf][0-9]*h?)$')
-while opted:
-  opass += 1
-  if verbose: sys.stderr.write('optimization pass ' + str(opass) + ': ')
-  opted = 0	# no optimizations performed
-  text_opt = [] # optimized code array, will be filled in during this pass
-  i = 0
-  while i < len(text):
-    if text[i].startswith('st'):
-      # stores (accu/x/y/zero) to pseudo-registers
-      r = storetopseudo.match(text[i])
-      if r:
-        # eliminate redundant stores
-        doopt = False
-        for j in range(i+1, min(len(text),i+30)):
-          r1 = re.match('st([axyz]).b tcc__' + r.groups()[1] + '$', text[j])
-          if r1:
-            doopt = True	# another store to the same pregister
-            break
-          if text[j].startswith('jsr.l ') and not text[j].startswith('jsr.l tcc__'):
-            doopt = True	# before function call (will be clobbered anyway)
-            break
-          # cases in which we don't pursue optimization further
-          if is_control(text[j]) or ('tcc__' + r.groups()[1]) in text[j]: break # branch or other use of the preg
-          if r.groups()[1].endswith('h') and ('[tcc__' + r.groups()[1].rstrip('h')) in text[j]: break # use as a pointer
-        if doopt:
-          i += 1 # skip redundant store
-          opted += 1
-          continue
-      
-      # stores (x/y) to pseudo-registers
-      r = storexytopseudo.match(text[i])
-      if r:
-        # store hwreg to preg, push preg, function call -> push hwreg, function call
-        if text[i+1] == 'pei (tcc__' + r.groups()[1] + ')' and text[i+2].startswith('jsr.l '):
-          text_opt += ['ph' + r.groups()[0]]
-          i += 2
-          opted += 1
-          continue
-        # store hwreg to preg, push preg -> store hwreg to preg, push hwreg (shorter)
-        if text[i+1] == 'pei (tcc__' + r.groups()[1] + ')':
-          text_opt += [text[i]]
-          text_opt += ['ph' + r.groups()[0]]
-          i += 2
-          opted += 1
-          continue
-        # store hwreg to preg, load hwreg from preg -> store hwreg to preg, transfer hwreg/hwreg (shorter)
-        if text[i+1] == 'lda.b tcc__' + r.groups()[1] or text[i+1] == 'lda.b tcc__' + r.groups()[1] + " ; DON'T OPTIMIZE":
-          text_opt += [text[i]]
-          text_opt += ['t' + r.groups()[0] + 'a'] # FIXME: shouldn't this be marked as DON'T OPTIMIZE again?
-          i += 2
-          opted += 1
-          continue
-      
-      # stores (accu only) to pseudo-registers
-      r = storeatopseudo.match(text[i])
-      if r:
-        #sys.stderr.write('looking for lda.b tcc__r' + r.groups()[0] + ' in ' + text[i+1] + '\n')
-        # store preg followed by load preg
-        if text[i+1] == 'lda.b tcc__' + r.groups()[0]:
-          #sys.stderr.write('found!\n')
-          text_opt += [text[i]]	# keep store
-          i += 2 # omit load
-          opted += 1
-          continue
-        # store preg followed by load preg with ldx/ldy in between
-        if (text[i+1].startswith('ldx') or text[i+1].startswith('ldy')) and text[i+2] == 'lda.b tcc__' + r.groups()[0]:
-          text_opt += [text[i]]	# keep store
-          text_opt += [text[i+1]]
-          i += 3 # omit load
-          opted += 1
-          continue
-        # store accu to preg, push preg, function call -> push accu, function call
-        if text[i+1] == 'pei (tcc__' + r.groups()[0] + ')' and text[i+2].startswith('jsr.l '):
-          text_opt += ['pha']
-          i += 2
-          opted += 1
-          continue
-        # store accu to preg, push preg -> store accu to preg, push accu (shorter)
-        if text[i+1] == 'pei (tcc__' + r.groups()[0] + ')':
-          text_opt += [text[i]]
-          text_opt += ['pha']
-          i += 2
-          opted += 1
-          continue
-        # store accu to preg1, push preg2, push preg1 -> store accu to preg1, push preg2, push accu
-        elif text[i+1].startswith('pei ') and text[i+2] == 'pei (tcc__' + r.groups()[0] + ')':
-          text_opt += [text[i+1]]
-          text_opt += [text[i]]
-          text_opt += ['pha']
-          i += 3
-          opted += 1
-          continue
-        
-        # convert incs/decs on pregs incs/decs on hwregs
-        cont = False
-        for crem in 'inc','dec':
-          if text[i+1] == crem + '.b tcc__' + r.groups()[0]:
-            # store to preg followed by crement on preg
-            if text[i+2] == crem + '.b tcc__' + r.groups()[0] and text[i+3].startswith('lda'):
-                # store to preg followed by two crements on preg
-                # increment the accu first, then store it to preg
-                text_opt += [crem + ' a',crem + ' a','sta.b tcc__' + r.groups()[0]]
-                # a subsequent load can be omitted (the right value is already in the accu)
-                if text[i+3] == 'lda.b tcc__' + r.groups()[0]: i += 4
-                else: i += 3
-                opted += 1
-                cont = True
-                break
-            elif text[i+2].startswith('lda'): #text[i+2] == 'lda.b tcc__' + r.groups()[0]:
-              # same thing with only one crement (FIXME: there should be a more clever way to do this...)
-              text_opt += [crem + ' a','sta.b tcc__' + r.groups()[0]]
-              if text[i+2] == 'lda.b tcc__' + r.groups()[0]: i += 3
-              else: i += 2
-              opted += 1
-              cont = True
-              break
-        if cont: continue
-        
-        r1 = re.match('lda.b tcc__([rf][0-9]*)',text[i+1])
-        if r1:
-          #sys.stderr.write('t '+text[i+2][:3]+'\n')
-          if text[i+2][:3] in ['and','ora']:
-            # store to preg1, load from preg2, and/or preg1 -> store to preg1, and/or preg2
-            #sys.stderr.write('found in line ' + str(i) + '!\n')
-            if text[i+2][3:] == '.b tcc__' + r.groups()[0]:
-              text_opt += [text[i]] # store
-              text_opt += [text[i+2][:3] + '.b tcc__' + r1.groups()[0]]
-              i += 3
-              opted += 1
-              continue
-        
-        # store to preg, switch to 8 bits, load from preg => skip the load
-        if text[i+1] == 'sep #$20' and text[i+2] == 'lda.b tcc__' + r.groups()[0]:
-          text_opt += [text[i]]
-          text_opt += [text[i+1]]
-          i += 3 # skip load
-          opted += 1
-          continue
-        
-        # two stores to preg without control flow or other uses of preg => skip first store
-        if not is_control(text[i+1]) and not ('tcc__' + r.groups()[0]) in text[i+1]:
-          if text[i+2] == text[i]:
-            text_opt += [text[i+1]]
-            text_opt += [text[i+2]]
-            i += 3 # skip first store
-            opted += 1
-            continue
-        
-        # store hwreg to preg, load hwreg from preg -> store hwreg to preg, transfer hwreg/hwreg (shorter)
-        r1 = re.match('ld([xy]).b tcc__' + r.groups()[0], text[i+1])
-        if r1:
-          text_opt += [text[i]]
-          text_opt += ['ta' + r1.groups()[0]]
-          i += 2
-          opted += 1
-          continue
-        
-        # store accu to preg then load accu from preg, with something in-between that does not alter
-        # control flow or touch accu or preg => skip load
-        if not (is_control(text[i+1]) or changes_accu(text[i+1]) or 'tcc__' + r.groups()[0] in text[i+1]):
-          if text[i+2] == 'lda.b tcc__' + r.groups()[0]:
-            text_opt += [text[i]]
-            text_opt += [text[i+1]]
-            i += 3 # skip load
-            opted += 1
-            continue
-        
-        # store preg1, clc, load preg2, add preg1 -> store preg1, clc, add preg2
-        if text[i+1] == 'clc':
-          r1 = re.match('lda.b tcc__(r[0-9]*)', text[i+2])
-          if r1 and text[i+3] == 'adc.b tcc__' + r.groups()[0]:
-            text_opt += [text[i]]
-            text_opt += [text[i+1]]
-            text_opt += ['adc.b tcc__' + r1.groups()[0]]
-            i += 4 # skip load
-            opted += 1
-            continue
-        
-        # store accu to preg, asl preg => asl accu, store accu to preg
-        # FIXME: is this safe? can we rely on code not making assumptions about the contents of the accu
-        # after the shift?
-        if text[i+1] == 'asl.b tcc__' + r.groups()[0]:
-          text_opt += ['asl a']
-          text_opt += [text[i]]
-          i += 2
-          opted += 1
-          continue
-        
-      r = re.match('sta (.*),s$', text[i])
-      if r:
-        if text[i+1] == 'lda ' + r.groups()[0] + ',s':
-          text_opt += [text[i]]
-          i += 2 # omit load
-          opted += 1
-          continue
-    # end startswith('st')
-    
-    if text[i].startswith('ld'):
-      r = re.match('ldx #0', text[i])
-      if r:
-        r1 = re.match('lda.l (.*),x$', text[i+1])
-        if r1 and not text[i+3].endswith(',x'):
-          text_opt += ['lda.l ' + r1.groups()[0]]
-          i += 2
-          opted += 1
-          continue
-        elif r1:
-          text_opt += ['lda.l ' + r1.groups()[0]]
-          text_opt += [text[i+2]]
-          text_opt += [text[i+3].replace(',x','')]
-          i += 4
-          opted += 1
-          continue
-      
-      if text[i].startswith('lda.w #') and \
-         text[i+1] == 'sta.b tcc__r9' and \
-         text[i+2].startswith('lda.w #') and \
-         text[i+3] == 'sta.b tcc__r9h' and \
-         text[i+4] == 'sep #$20' and \
-         text[i+5].startswith('lda.b ') and \
-         text[i+6] == 'sta.b [tcc__r9]' and \
-         text[i+7] == 'rep #$20':
-        text_opt += ['sep #$20']
-        text_opt += [text[i+5]]
-        text_opt += ['sta.l ' + str(int(text[i+2][7:]) * 65536 + int(text[i][7:]))]
-        text_opt += ['rep #$20']
-        i += 8
-        opted += 1
-        #sys.stderr.write('7')
-        continue
-      
-      if text[i] == 'lda.w #0':
-        if text[i+1].startswith('sta.b ') and text[i+2].startswith('lda'):
-          text_opt += [text[i+1].replace('sta.','stz.')]
-          i += 2
-          opted += 1
-          continue
-      elif text[i].startswith('lda.w #'):
-        if text[i+1] == 'sep #$20' and text[i+2].startswith('sta ') and text[i+3] == 'rep #$20' and text[i+4].startswith('lda'):
-          text_opt += ['sep #$20', text[i].replace('lda.w', 'lda.b'), text[i+2], text[i+3]]
-          i += 4
-          opted += 1
-          continue
-    
-      if text[i].startswith('lda.b') and not is_control(text[i+1]) and not 'a' in text[i+1] and text[i+2].startswith('lda.b'):
-        text_opt += [text[i+1],text[i+2]]
-        i += 3
-        opted += 1
-        continue
-      
-      # don't write preg high back to stack if it hasn't been updated
-      if text[i+1].endswith('h') and text[i+1].startswith('sta.b tcc__r') and text[i].startswith('lda ') and text[i].endswith(',s'):
-        #sys.stderr.write('checking lines\n')
-        #sys.stderr.write(text[i] + '\n' + text[i+1] + '\n')
-        local = text[i][4:]
-        reg = text[i+1][6:]
-        # lda stack ; store high preg ; ... ; load high preg ; sta stack
-        j = i + 2
-        while j < len(text) - 2 and not is_control(text[j]) and not reg in text[j]:
-          j += 1
-        if text[j] == 'lda.b ' + reg and text[j+1] == 'sta ' + local:
-          while i < j:
-            text_opt += [text[i]]
-            i += 1
-          i += 2 # skip load high preg ; sta stack
-          opted += 1
-          continue
-      
-      # reorder copying of 32-bit value to preg if it looks as if that could
-      # allow further optimization
-      # looking for
-      #   lda something
-      #   sta.b tcc_rX
-      #   lda something
-      #   sta.b tcc_rYh
-      #   ...tcc_rX...
-      if text[i].startswith('lda') and text[i+1].startswith('sta.b tcc__r'):
-        reg = text[i+1][6:]
-        if not reg.endswith('h') and \
-           text[i+2].startswith('lda') and not text[i+2].endswith(reg) and \
-           text[i+3].startswith('sta.b tcc__r') and text[i+3].endswith('h') and \
-           text[i+4].endswith(reg):
-          text_opt += [text[i+2], text[i+3]]
-          text_opt += [text[i], text[i+1]]
-          i += 4
-          # this is not an optimization per se, so we don't count it
-          continue
-      
-      # compare optimizations inspired by optimore
-      # These opts simplify compare operations, which are monstrous because
-      # they have to take the long long case into account.
-      # We try to detect those cases by checking if a tya follows the
-      # comparison (not sure if this is reliable, but it passes the test suite)
-      if text[i] == 'ldx #1' and \
-         text[i+1].startswith('lda.b tcc__') and \
-         text[i+2] == 'sec' and \
-         text[i+3].startswith('sbc #') and \
-         text[i+4] == 'tay' and \
-         text[i+5] == 'beq +' and \
-         text[i+6] == 'dex' and \
-         text[i+7] == '+' and \
-         text[i+8].startswith('stx.b tcc__') and \
-         text[i+9] == 'txa' and \
-         text[i+10] == 'bne +' and \
-         text[i+11].startswith('brl ') and \
-         text[i+12] == '+' and \
-         text[i+13] != 'tya':
-        text_opt += [text[i+1]]
-        text_opt += ['cmp #' + text[i+3][5:]]
-        text_opt += [text[i+5]]
-        text_opt += [text[i+11]]	# brl
-        text_opt += [text[i+12]]	# +
-        i += 13
-        opted += 1
-        #sys.stderr.write('1')
-        continue
-      
-      if text[i] == 'ldx #1' and \
-         text[i+1] == 'sec' and \
-         text[i+2].startswith('sbc #') and \
-         text[i+3] == 'tay' and \
-         text[i+4] == 'beq +' and \
-         text[i+5] == 'dex' and \
-         text[i+6] == '+' and \
-         text[i+7].startswith('stx.b tcc__') and \
-         text[i+8] == 'txa' and \
-         text[i+9] == 'bne +' and \
-         text[i+10].startswith('brl ') and \
-         text[i+11] == '+' and \
-         text[i+12] != 'tya':
-        text_opt += ['cmp #' + text[i+2][5:]]
-        text_opt += [text[i+4]]
-        text_opt += [text[i+10]]	# brl
-        text_opt += [text[i+11]]	# +
-        i += 12
-        opted += 1
-        #sys.stderr.write('2')
-        continue
-      
-      if text[i] == 'ldx #1' and \
-         text[i+1].startswith('lda.b tcc__r') and \
-         text[i+2] == 'sec' and \
-         text[i+3].startswith('sbc.b tcc__r') and \
-         text[i+4] == 'tay' and \
-         text[i+5] == 'beq +' and \
-         text[i+6] == 'bcs ++' and \
-         text[i+7] == '+ dex' and \
-         text[i+8] == '++' and \
-         text[i+9].startswith('stx.b tcc__r') and \
-         text[i+10] == 'txa' and \
-         text[i+11] == 'bne +' and \
-         text[i+12].startswith('brl ') and \
-         text[i+13] == '+' and \
-         text[i+14] != 'tya':
-        text_opt += [text[i+1]]
-        text_opt += ['cmp.b ' + text[i+3][6:]]
-        text_opt += [text[i+5]]
-        text_opt += ['bcc +']
-        text_opt += ['brl ++']
-        text_opt += ['+']
-        text_opt += [text[i+12]]
-        text_opt += ['++']
-        i += 14
-        opted += 1
-        #sys.stderr.write('3')
-        continue
-      
-      if text[i] == 'ldx #1' and \
-         text[i+1] == 'sec' and \
-         text[i+2].startswith('sbc.w #') and \
-         text[i+3] == 'tay' and \
-         text[i+4] == 'bvc +' and \
-         text[i+5] == 'eor #$8000' and \
-         text[i+6] == '+' and \
-         text[i+7] == 'bmi +++' and \
-         text[i+8] == '++' and \
-         text[i+9] == 'dex' and \
-         text[i+10] == '+++' and \
-         text[i+11].startswith('stx.b tcc__r') and \
-         text[i+12] == 'txa' and \
-         text[i+13] == 'bne +' and \
-         text[i+14].startswith('brl ') and \
-         text[i+15] == '+' and \
-         text[i+16] != 'tya':
-        text_opt += [text[i+1]]
-        text_opt += [text[i+2]]
-        text_opt += [text[i+4]]
-        text_opt += ['eor #$8000']
-        text_opt += ['+']
-        text_opt += ['bmi +']
-        text_opt += [text[i+14]]
-        text_opt += ['+']
-        i += 16
-        opted += 1
-        #sys.stderr.write('4')
-        continue
-        
-      if text[i] == 'ldx #1' and \
-         text[i+1].startswith('lda.b tcc__r') and \
-         text[i+2] == 'sec' and \
-         text[i+3].startswith('sbc.b tcc__r') and \
-         text[i+4] == 'tay' and \
-         text[i+5] == 'bvc +' and \
-         text[i+6] == 'eor #$8000' and \
-         text[i+7] == '+' and \
-         text[i+8] == 'bmi +++' and \
-         text[i+9] == '++' and \
-         text[i+10] == 'dex' and \
-         text[i+11] == '+++' and \
-         text[i+12].startswith('stx.b tcc__r') and \
-         text[i+13] == 'txa' and \
-         text[i+14] == 'bne +' and \
-         text[i+15].startswith('brl ') and \
-         text[i+16] == '+' and \
-         text[i+17] != 'tya':
-        text_opt += [text[i+1]]
-        text_opt += [text[i+2]]
-        text_opt += [text[i+3]]
-        text_opt += [text[i+5]]
-        text_opt += [text[i+6]]
-        text_opt += ['+']
-        text_opt += ['bmi +']
-        text_opt += [text[i+15]]
-        text_opt += ['+']
-        i += 17
-        opted += 1
-        #sys.stderr.write('5')
-        continue
-        
-      if text[i] == 'ldx #1' and \
-         text[i+1] == 'sec' and \
-         text[i+2].startswith('sbc.b tcc__r') and \
-         text[i+3] == 'tay' and \
-         text[i+4] == 'bvc +' and \
-         text[i+5] == 'eor #$8000' and \
-         text[i+6] == '+' and \
-         text[i+7] == 'bmi +++' and \
-         text[i+8] == '++' and \
-         text[i+9] == 'dex' and \
-         text[i+10] == '+++' and \
-         text[i+11].startswith('stx.b tcc__r') and \
-         text[i+12] == 'txa' and \
-         text[i+13] == 'bne +' and \
-         text[i+14].startswith('brl ') and \
-         text[i+15] == '+' and \
-         text[i+16] != 'tya':
-        text_opt += [text[i+1]]
-        text_opt += [text[i+2]]
-        text_opt += [text[i+4]]
-        text_opt += [text[i+5]]
-        text_opt += ['+']
-        text_opt += ['bmi +']
-        text_opt += [text[i+14]]
-        text_opt += ['+']
-        i += 16
-        opted += 1
-        #sys.stderr.write('6')
-        continue
-        
-    # end startswith('ld') 
-    
-    if text[i] == 'rep #$20' and text[i+1] == 'sep #$20':
-      i += 2
-      opted += 1
-      continue
-    
-    if text[i] == 'sep #$20' and text[i+1].startswith('lda #') and text[i+2] == 'pha' and text[i+3].startswith('lda #') and text[i+4] == 'pha':
-      text_opt += ['pea.w (' + text[i+1].split('#')[1] + ' * 256 + ' + text[i+3].split('#')[1] + ')']
-      text_opt += [text[i]]
-      i += 5
-      opted += 1
-      continue
-    
-    r = re.match('adc #(.*)$',text[i])
-    if r:
-      r1 = re.match('sta.b (tcc__[fr][0-9]*)$', text[i+1])
-      if r1:
-        if text[i+2] == 'inc.b ' + r1.groups()[0] and text[i+3] == 'inc.b ' + r1.groups()[0]:
-          text_opt += ['adc #' + r.groups()[0] + ' + 2']
-          text_opt += [text[i+1]]
-          i += 4
-          opted += 1
-          continue
-    
-    if text[i][:6] in ['lda.l ','sta.l ']:
-      cont = False
-      for b in bss:
-        if text[i][2:].startswith('a.l ' + b + ' '):
-          text_opt += [text[i].replace('lda.l','lda.w').replace('sta.l','sta.w')]
-          i += 1
-          opted += 1
-          cont = True
-          break
-      if cont: continue
-    
-    if text[i].startswith('jmp.w ') or text[i].startswith('bra __'):
-      j = i + 1
-      cont = False
-      while j < len(text) and text[j].endswith(':'):
-        if text[i].endswith(text[j][:-1]):
-          # redundant branch, discard it
-          i += 1
-          opted += 1
-          cont = True
-          break
-        j += 1
-      if cont: continue
-
-    if text[i].startswith('jmp.w '):
-      # worst case is a 4-byte instruction, so if the jump target is closer
-      # than 32 instructions, we can safely substitute a branch
-      label = text[i][6:] + ':'
-      cont = False
-      for lpos in range(max(0, i - 32), min(len(text), i + 32)):
-        if text[lpos] == label:
-          text_opt += [text[i].replace('jmp.w','bra')]
-          i += 1
-          opted += 1
-          cont = True
-          break
-      if cont: continue
-      
-    text_opt += [text[i]]
-    i += 1
-  text = text_opt
-  if verbose: sys.stderr.write(str(opted) + ' optimizations performed\n')
-  totalopt += opted
-  
-for l in text_opt: print l
-if verbose: sys.stderr.write(str(totalopt) + ' optimizations performed in total\n')
-
-#prof.stop()
+#!/usr/bin/python
+
+import sys
+import re
+import os
+import getopt
+import traceback
+
+#import hotshot
+#prof = hotshot.Profile('816-opt.prof')
+#prof.start()
+
+verbose = True
+if os.getenv('OPT816_QUIET'): verbose = False
+# OPT816_GOAL=size only applies rewrites that don't make the code bigger;
+# by default, they must not make it slower (see rule_gain())
+goal = os.getenv('OPT816_GOAL', 'speed')
+# OPT816_STATS=1 prints how often each rule was applied, and what it saved,
+# to stderr; OPT816_STATS=<file> appends it to file, and
+# '816-opt.py --stats <file>' sums up the statistics collected there
+stats_to = os.getenv('OPT816_STATS')
+# most peephole rules are in 816-opt.rules, next to this script;
+# OPT816_RULES=<file> uses the rules in file instead
+rules_path = os.getenv('OPT816_RULES') or \
+             os.path.join(os.path.dirname(os.path.abspath(__file__)), '816-opt.rules')
+
+def print_stats(stats, out):
+  src = open(__file__).read().split('\n')
+  rules_src = [l.rstrip('\r\n') for l in open(rules_path)]
+  rule_at = dict([(r.name, r.lineno) for r in rules])
+  out.write('%-22s %7s %7s %8s %8s\n' % ('rule', 'hits', 'skipped', 'bytes', 'cycles'))
+  for k, v in sorted(stats.items(), key = lambda e: (-e[1][3], -e[1][2], e[0])):
+    # describe the rule by the first line of the comment above it: in the
+    # rule file, or here, above the function of that name
+    lines, n = rules_src, rule_at.get(k, 0) - 1
+    if n < 0:
+      lines = src
+      n = ('def %s(text, i):' % k) in src and src.index('def %s(text, i):' % k) or 0
+    desc = ''
+    if n > 0 and lines[n-1].startswith('# '):
+      while n > 0 and lines[n-1].startswith('# '): n -= 1
+      desc = lines[n][2:]
+    out.write('%-22s %7d %7d %8d %8d  %s\n' % (k, v[0], v[1], v[2], v[3], desc[:50]))
+
+# progress messages, prefixed with the name of the file in batch mode
+note_prefix = ''
+def note(msg):
+  if verbose: sys.stderr.write(note_prefix + msg + '\n')
+
+# the lines of the assembler file name, without the comments
+def read_ps(name):
+  text = []
+  for l in open(name, 'r').readlines():
+    if not l.startswith(';'): text += [l.strip()]
+  return text
+
+# find the symbols in RAM in bank $7e (.bss, and any other ramsection put
+# there), which the data bank register points to, so they can be accessed
+# with absolute instead of long addressing. The RAM copy of .data is in bank
+# $7f and has to be accessed with long addressing.
+def find_bss(text):
+  bss = set()
+  bsson = False
+  for l in text:
+    if l.startswith('.ramsection ') and ' bank $7e ' in l:
+      bsson = True
+      continue
+    if l == '.ends':
+      bsson = False
+    if bsson and l:
+      bss.add(l.split(' ')[0])
+  return bss
+bss = set()	# of the file being optimized
+
+# checks if the line alters the control flow
+def is_control(line):
+  if len(line) > 0 and line[0] in 'jb+-' or line.endswith(':'): return True
+  return False
+
+def changes_accu(line):
+  if (line[2] == 'a' and not line[:3] in ['pha','sta']) or (len(line) == 5 and line.endswith(' a')): return True
+  else: return False
+
+# basic block IR
+#
+# The rules in the main loop only look at a few lines at a time. The passes
+# below work on whole functions: the code of each function is split into
+# basic blocks, the pseudo-registers are treated as the function's virtual
+# registers, and constants and copies are propagated along the control flow
+# graph. Loads of values the accu or the index registers hold already are
+# removed or become transfers, and stores to pseudo-registers that are never
+# read again are removed.
+# OPT816_DUMP_IR=1 prints the blocks of every function to stderr.
+
+dump_ir = os.getenv('OPT816_DUMP_IR')
+
+# the 16-bit halves of the pseudo-registers
+pregs = []
+for p in ['r0','r1','r2','r3','r4','r5','r9','r10','f0','f1','f2','f3']: pregs += [p, p + 'h']
+all_pregs = frozenset(pregs)
+# pseudo-registers the caller may read after rtl (REG_IRET, REG_LRET, REG_FRET)
+ret_pregs = frozenset(['r0','r0h','r1','r1h','f0','f0h'])
+# pseudo-registers read and clobbered by the helpers in libtcc.asm; calls of
+# other helpers are assumed to read all of them and change none
+helper_pregs = {
+  'tcc__mul': (('r9','r10'), ('r9','r10')),
+  'tcc__mull': (('r9','r9h','r10','r10h'), ('r9','r9h','r10','r10h')),
+  'tcc__udiv': ((), ('r9',)),
+  'tcc__div': ((), ('r9','r10')),
+  'tcc__divdi3': ((), ('r0','r1','r9','r9h','r10','r10h')),
+  'tcc__moddi3': ((), ('r0','r1','r9','r9h','r10','r10h')),
+  'tcc__udivdi3': ((), ('r0','r1','r9','r9h','r10','r10h')),
+  'tcc__umoddi3': ((), ('r0','r1','r9','r9h','r10','r10h')),
+  'tcc__shldi3': ((), ('r0','r1')),
+  'tcc__sardi3': ((), ('r0','r1')),
+  'tcc__shrdi3': ((), ('r0','r1')),
+  # calls through function pointers; the callee clobbers everything
+  'tcc__jsl_r10': (('r10','r10h'), pregs),
+  'tcc__jsl_ind_r9': (('r9','r9h'), pregs),
+  'tcc__prof_enter': ((), ()),
+  'tcc__prof_exit': ((), ()),
+}
+
+branches = ['bcc','bcs','beq','bmi','bne','bpl','bvc','bvs']
+jumps = ['bra','brl','jmp','jml']
+# instructions that only read their operand
+read_ops = ['lda','adc','sbc','and','ora','eor','cmp','bit','ldx','ldy','cpx','cpy','pei']
+# ... only write it
+write_ops = ['sta','stx','sty','stz']
+# ... and that change neither the accumulator nor the M flag
+keeps_accu = ['sta','stx','sty','stz','ldx','ldy','inx','iny','dex','dey','cpx','cpy','cmp','bit',
+              'pha','phx','phy','phb','phd','phk','php','pei','pea','plx','ply','plb','pld',
+              'tax','tay','tas','tcs','txs','tcd','tad','txy','tyx','tsx','clc','sec','cli','sei',
+              'cld','sed','clv','nop','inc','dec','asl','lsr','rol','ror','tsb','trb'] + branches
+
+# instructions that change the index registers
+writes_x = ['ldx','tax','tsx','tyx','inx','dex','plx','mvn','mvp']
+writes_y = ['ldy','tay','txy','iny','dey','ply','mvn','mvp']
+# ... that set the N and Z flags according to a result, and those that read
+# them
+sets_nz = ['lda','ldx','ldy','adc','sbc','and','ora','eor','cmp','cpx','cpy','inc','dec',
+           'inx','iny','dex','dey','tax','tay','txa','tya','txy','tyx','tsx','tsa','tsc','tdc',
+           'tcd','pla','plx','ply','plb','pld','asl','lsr','rol','ror','xba']
+reads_nz = ['beq','bne','bmi','bpl','php']
+
+# ... and that work the same with an 8-bit or a 16-bit accu (the index
+# registers are always 16 bits wide here)
+width_indep = ['ldx','ldy','stx','sty','inx','iny','dex','dey','cpx','cpy','phx','phy','plx','ply',
+               'phb','plb','phd','pld','phk','pea','pei','tax','tay','txy','tyx','tsx','txs',
+               'tcs','tcd','tsc','tdc','xba','clc','sec','cli','sei','clv','nop',
+               'bra','brl','jmp'] + branches
+
+preg_operand = re.compile('tcc__([rf][0-9]+h?)( \+ [0-9]+)?$')
+preg_indirect = re.compile('\[tcc__([rf][0-9]+)\](, ?y)?$')
+preg_pei = re.compile('\(tcc__([rf][0-9]+h?)\)$')
+preg_any = re.compile('tcc__[rf][0-9]')
+# any use of one of the pseudo-registers (either half)
+preg_use = dict([(p, re.compile('tcc__' + p + '(?![0-9])')) for p in pregs if not p.endswith('h')])
+
+class Insn:
+  def __init__(self, line):
+    self.text = line
+    self.label = None	# label defined by this line
+    self.op = None	# mnemonic, or the whole line for directives
+    self.size = ''	# .b/.w/.l suffix
+    self.arg = ''
+    self.noopt = "DON'T OPTIMIZE" in line
+    self.cond = False	# inside an .if block
+    self.deleted = False
+    if not line: return
+    if line.endswith(':'):
+      self.label = line[:-1]
+      return
+    if line[0] in '+-':
+      # anonymous label, optionally followed by an instruction
+      n = len(line) - len(line.lstrip('+-'))
+      self.label = line[:n]
+      line = line[n:].strip()
+      if not line: return
+    if line[0] == '.':
+      self.op = line
+      return
+    line = line.split(';')[0].strip()
+    f = line.split(' ', 1)
+    self.op = f[0].split('.')[0]
+    if '.' in f[0]: self.size = f[0].split('.')[1]
+    if len(f) > 1: self.arg = f[1].strip()
+
+  def is_directive(self):
+    return self.op and self.op[0] == '.'
+
+  # the pseudo-register accesses of this instruction, as (uses, defs, partial)
+  # with partial the pseudo-registers that are only partly written. None if
+  # the operand refers to pseudo-registers in a way we don't understand.
+  def preg_access(self, m16):
+    if not preg_any.search(self.arg): return (), (), ()
+    if self.op in ['jsr','jsl','jml','jmp']: return None
+    r = preg_operand.match(self.arg)
+    if r:
+      p = r.groups()[0]
+      if not p in all_pregs: return None
+      if r.groups()[1]:
+        # unaligned access; touches the next half, too
+        i = pregs.index(p)
+        ps = tuple(pregs[i:i+2])
+        if self.op in read_ops: return ps, (), ()
+        if self.op in write_ops: return (), (), ps
+        return ps, (), ps
+      if self.op in read_ops: return (p,), (), ()
+      if self.op in write_ops:
+        # stx/sty are always 16 bits wide; 8-bit accu stores only
+        # write the low byte
+        if self.op in ['stx','sty'] or m16 == True: return (), (p,), ()
+        return (), (), (p,)
+      return (p,), (), (p,)
+    r = preg_indirect.match(self.arg)
+    if r:
+      p = r.groups()[0]
+      if not p in all_pregs: return None
+      return (p, p + 'h'), (), ()
+    r = preg_pei.match(self.arg)
+    if r and self.op == 'pei' and r.groups()[0] in all_pregs:
+      return (r.groups()[0],), (), ()
+    return None
+
+  def is_call(self):
+    return self.op in ['jsr','jsl']
+
+  # calls of helper functions in libtcc/libm, which take arguments in
+  # pseudo-registers
+  def is_helper_call(self):
+    return self.is_call() and self.arg.startswith('tcc__')
+
+  def is_branch(self):
+    return self.op in branches or self.op in jumps
+
+  def ends_block(self):
+    return self.is_branch() or self.op in ['rtl','rts','rti']
+
+class Block:
+  def __init__(self, n):
+    self.n = n
+    self.insns = []
+    self.succs = []
+    self.preds = []
+    self.exit = False	# control may leave the function
+    self.unknown_preds = False	# may be entered from an indirect jump
+    self.state = None	# entry state of the forward analysis
+    self.live = None	# pseudo-registers live on entry
+    self.width_live = None	# accu width read before it is set again
+
+class Function:
+  def __init__(self, lines):
+    self.insns = [Insn(l) for l in lines]
+    self.name = [i.label for i in self.insns if i.label][0]
+    self.ok = True
+    cond = 0
+    for i in self.insns:
+      if i.is_directive():
+        if i.op.startswith('.if'): cond += 1
+        elif i.op.startswith('.endif'): cond -= 1
+      elif i.op:
+        i.cond = cond > 0
+        if i.op in ['xce','plp','rep','sep'] and \
+           not (i.op == 'rep' and i.arg in ['#$10','#$20','#$30']) and \
+           not (i.op == 'sep' and i.arg == '#$20'):
+          self.ok = False	# mode changes we don't follow
+        if i.preg_access(None) is None: self.ok = False
+    if self.ok: self.build_blocks()
+
+  def build_blocks(self):
+    self.blocks = []
+    b = None
+    for i in self.insns:
+      if b is None or i.label is not None or (b.insns and b.insns[-1].ends_block()):
+        b = Block(len(self.blocks))
+        self.blocks += [b]
+      b.insns += [i]
+    # resolve branch targets
+    labels = {}
+    for b in self.blocks:
+      if b.insns[0].label is not None and not b.insns[0].label[0] in '+-':
+        labels[b.insns[0].label] = b
+    indirect = False
+    for b in self.blocks:
+      last = b.insns[-1]
+      fall = b.n + 1 < len(self.blocks)
+      if last.is_branch():
+        t = last.arg
+        target = None
+        if t and t[0] == '+' and t == len(t) * '+':
+          for b2 in self.blocks[b.n+1:]:
+            if b2.insns[0].label == t:
+              target = b2
+              break
+        elif t and t[0] == '-' and t == len(t) * '-':
+          for b2 in reversed(self.blocks[:b.n+1]):
+            if b2.insns[0].label == t:
+              target = b2
+              break
+        else:
+          target = labels.get(t)
+        if target: b.succs += [target]
+        else:
+          b.exit = True
+          if last.op == 'jml': indirect = True
+        if not last.op in branches: fall = False
+      elif last.op in ['rtl','rts','rti']:
+        b.exit = True
+        fall = False
+      if fall: b.succs += [self.blocks[b.n + 1]]
+      elif not b.succs and not b.exit: b.exit = True
+    for b in self.blocks:
+      for s in b.succs: s.preds += [b]
+      if indirect and b.n and b.insns[0].label and not b.insns[0].label[0] in '+-':
+        b.unknown_preds = True
+
+  # forward analysis: accu width, and the pseudo-registers, the accu and
+  # the index registers ('x' and 'y' among the pseudo-registers) holding a
+  # known constant ('#...') or a copy of a pseudo-register
+  def meet(self, a, b):
+    if a is None: return b
+    if b is None: return a
+    m = None
+    if a[0] == b[0]: m = a[0]
+    acc = None
+    if a[1] == b[1]: acc = a[1]
+    vals = {}
+    for k in a[2]:
+      if k in b[2] and a[2][k] == b[2][k]: vals[k] = a[2][k]
+    return (m, acc, vals)
+
+  # apply insn i to state (m16, accu, values); rewrite is called for every
+  # instruction reading a pseudo-register
+  def transfer(self, i, state, rewrite = None):
+    if i.op is None or i.deleted or i.is_directive(): return state
+    uses, defs, partial = i.preg_access(state[0])
+    if rewrite and uses and not i.noopt and not i.cond: rewrite(i, state[0], state[2])
+    if i.cond:
+      # conditionally assembled code may or may not be there
+      return self.meet(state, self.transfer_insn(i, state, uses, defs, partial))
+    return self.transfer_insn(i, state, uses, defs, partial)
+
+  def transfer_insn(self, i, state, uses, defs, partial):
+    m16, acc, vals = state
+    vals = dict(vals)
+    if i.is_call():
+      return (m16, None, {})
+    for p in defs + partial:
+      # forget everything that depends on the old value
+      for k in list(vals.keys()):
+        if k == p or vals[k] == p: del vals[k]
+      if acc == p: acc = None
+    if i.op in ['sta','stz','stx','sty'] and defs:
+      p = defs[0]
+      v = {'sta': acc, 'stz': '#0', 'stx': vals.get('x'), 'sty': vals.get('y')}[i.op]
+      if v and v != p: vals[p] = v
+    for r, writes in [('x', writes_x), ('y', writes_y)]:
+      if i.op in writes:
+        v = None
+        if i.op == 'ld' + r: v = self.value(i, vals)
+        elif i.op == 'ta' + r: v = acc
+        elif i.op in ['txy','tyx']: v = vals.get(i.op[1])
+        if v: vals[r] = v
+        elif r in vals: del vals[r]
+    if i.op in ['rep','sep']:
+      if i.arg == '#$20' or i.arg == '#$30': m16 = i.op == 'rep'
+    elif i.op == 'lda' and m16 == True:
+      acc = self.value(i, vals)
+    elif i.op in ['txa','tya'] and m16 == True:
+      acc = vals.get(i.op[1])
+    elif not (i.op in keeps_accu and (i.arg not in ['','a'] or not i.op in ['inc','dec','asl','lsr','rol','ror'])):
+      acc = None
+    return (m16, acc, vals)
+
+  # the value a load gets from its operand, if it is a constant or a
+  # pseudo-register
+  def value(self, i, vals):
+    if i.arg.startswith('#'): return i.arg
+    r = preg_operand.match(i.arg)
+    if r and not r.groups()[1]: return vals.get(r.groups()[0], r.groups()[0])
+    return None
+
+  def analyze(self):
+    entry = (True, None, {})
+    for b in self.blocks: b.state = None
+    self.blocks[0].state = entry
+    work = [self.blocks[0]]
+    for b in self.blocks:
+      if b.unknown_preds:
+        b.state = (None, None, {})
+        work += [b]
+    while work:
+      b = work.pop()
+      s = b.state
+      for i in b.insns: s = self.transfer(i, s)
+      for s2 in b.succs:
+        new = self.meet(s2.state, s)
+        if new != s2.state:
+          s2.state = new
+          if not s2 in work: work += [s2]
+
+  # replace reads of pseudo-registers with known contents
+  def propagate(self):
+    count = [0]
+    def rewrite(i, m16, vals):
+      if not i.op in read_ops or i.op == 'pei': return
+      r = preg_operand.match(i.arg)
+      if not r or r.groups()[1]: return
+      p = r.groups()[0]
+      v = vals.get(p)
+      if v is None: return
+      if v[0] == '#':
+        if i.op in ['ldx','ldy','cpx','cpy']: new = i.op + '.w ' + v
+        elif m16 == True and i.op != 'bit': new = i.op + '.w ' + v
+        else: return
+      else:
+        new = i.op + '.b tcc__' + v
+      i.text = new
+      i.op, i.size, i.arg = Insn(new).op, Insn(new).size, Insn(new).arg
+      count[0] += 1
+    for b in self.blocks:
+      if b.state is None: continue	# unreachable
+      s = b.state
+      for i in b.insns:
+        s = self.transfer(i, s, rewrite)
+    return count[0]
+
+  # are the N and Z flags insn n of block b sets overwritten before they are
+  # read? Only the rest of the block is looked at.
+  def nz_dead_after(self, b, n):
+    for i in b.insns[n+1:]:
+      if i.op is None or i.deleted: continue
+      if i.is_directive() or i.op in reads_nz or i.ends_block() or i.is_call(): return False
+      if i.op in sets_nz and not i.cond: return True
+    return False
+
+  # Loads of the value the register holds already are removed, loads of a
+  # value another register holds become transfers: the same flags, but
+  # shorter and faster. The transfers move as many bytes as the load would
+  # (X and Y are always 16 bits wide), and the accu is only tracked as a
+  # whole, so the accu width doesn't matter.
+  def reuse_values(self):
+    count = 0
+    for b in self.blocks:
+      if b.state is None: continue
+      s = b.state
+      for n, i in enumerate(b.insns):
+        if i.op in ['lda','ldx','ldy'] and not i.deleted and not i.cond and not i.noopt and \
+           not i.label and s[0] is not None:
+          v = self.value(i, s[2])
+          regs = {'a': s[1], 'x': s[2].get('x'), 'y': s[2].get('y')}
+          r = i.op[2]
+          if v and regs[r] == v and self.nz_dead_after(b, n):
+            i.deleted = True
+            count += 1
+          elif v:
+            for src in 'axy':
+              if src != r and regs[src] == v:
+                new = 't' + src + r
+                i.text, i.op, i.size, i.arg = new, new, '', ''
+                count += 1
+                break
+        s = self.transfer(i, s)
+    return count
+
+  # the pseudo-registers live before insn i, given those live after it
+  def live_before(self, i, m16, live):
+    if i.op is None or i.deleted or i.is_directive(): return live
+    if i.is_call():
+      if i.arg in helper_pregs:
+        uses, defs = helper_pregs[i.arg]
+        return (live - set(defs)) | set(uses)
+      if i.is_helper_call(): return set(all_pregs)
+      return set()	# arguments are passed on the stack
+    if i.op == 'jml': return set(all_pregs)
+    uses, defs, partial = i.preg_access(m16)
+    if i.cond: return live | set(uses)	# may not be assembled
+    return (live - set(defs)) | set(uses)
+
+  # the pseudo-registers live after the last insn of block b
+  def live_out(self, b):
+    live = set()
+    if b.exit:
+      if b.insns[-1].op in ['rtl','rts']: live = set(ret_pregs)
+      else: live = set(all_pregs)
+    for s in b.succs:
+      if s.live is not None: live |= s.live
+    return live
+
+  # accu width before each insn of block b
+  def widths(self, b):
+    m = []
+    s = b.state
+    for i in b.insns:
+      m += [s[0]]
+      s = self.transfer(i, s)
+    return m
+
+  # backward liveness analysis of the pseudo-registers over the control
+  # flow graph
+  def liveness(self):
+    m = {}
+    for b in self.blocks:
+      b.live = None
+      if b.state is not None: m[b] = self.widths(b)
+    work = [b for b in self.blocks]
+    while work:
+      b = work.pop()
+      if b.state is None:
+        live = set(all_pregs)	# unreachable
+      else:
+        live = self.live_out(b)
+        for n in range(len(b.insns) - 1, -1, -1):
+          live = self.live_before(b.insns[n], m[b][n], live)
+      if live != b.live:
+        b.live = live
+        for p in b.preds:
+          if not p in work: work += [p]
+    return m
+
+  # remove stores to pseudo-registers that are not read on any path before
+  # they are overwritten or clobbered
+  def eliminate_stores(self):
+    count = 0
+    m = self.liveness()
+    for b in self.blocks:
+      if b.state is None: continue
+      live = self.live_out(b)
+      for n in range(len(b.insns) - 1, -1, -1):
+        i = b.insns[n]
+        if i.op and not i.is_directive() and not i.is_call() and not i.cond and \
+           not i.noopt and not i.label:
+          uses, defs, partial = i.preg_access(m[b][n])
+          if (defs or partial) and not uses:
+            if not [p for p in defs + partial if p in live]:
+              i.deleted = True
+              count += 1
+              continue
+        live = self.live_before(i, m[b][n], live)
+    return count
+
+  # is insn i a switch of the accu width that can be moved or removed?
+  def is_width_switch(self, i, op = None):
+    return not i.deleted and not i.cond and not i.noopt and not i.label and \
+           i.op in ['rep','sep'] and i.arg == '#$20' and (op is None or i.op == op)
+
+  # is the accu width read on some path from before insn i on, given whether
+  # it is read from after it on?
+  def width_live_before(self, i, live):
+    if i.op is None or i.deleted or i.is_directive(): return live
+    if i.op in ['rep','sep'] and i.arg in ['#$20','#$30'] and not i.cond: return False
+    if i.op in width_indep: return live
+    return True	# calls and returns expect a 16-bit accu
+
+  def width_live_out(self, b):
+    if b.exit: return True
+    return True in [s.width_live for s in b.succs]
+
+  # backward analysis: where does the accu width matter?
+  def width_liveness(self):
+    for b in self.blocks: b.width_live = None
+    work = [b for b in self.blocks]
+    while work:
+      b = work.pop()
+      live = self.width_live_out(b)
+      for i in reversed(b.insns): live = self.width_live_before(i, live)
+      if live != b.width_live:
+        b.width_live = live
+        for p in b.preds:
+          if not p in work: work += [p]
+
+  # accu width at the end of block b
+  def width_out(self, b):
+    s = b.state
+    for i in b.insns: s = self.transfer(i, s)
+    return s[0]
+
+  # insert line before the insn at index n of block b
+  def insert(self, b, n, line):
+    i = Insn(line)
+    if n < len(b.insns): self.insns.insert(self.insns.index(b.insns[n]), i)
+    else: self.insns.insert(self.insns.index(b.insns[-1]) + 1, i)
+    b.insns.insert(n, i)
+
+  # remove rep/sep #$20 that leave the accu width as it is, or set a width
+  # nothing reads
+  def remove_width_switches(self):
+    count = 0
+    self.analyze()
+    for b in self.blocks:
+      if b.state is None: continue
+      for i, m16 in zip(b.insns, self.widths(b)):
+        if self.is_width_switch(i) and m16 == (i.op == 'rep'):
+          i.deleted = True
+          count += 1
+    self.width_liveness()
+    for b in self.blocks:
+      if b.state is None: continue
+      live = self.width_live_out(b)
+      for i in reversed(b.insns):
+        if self.is_width_switch(i) and not live:
+          i.deleted = True
+          count += 1
+          continue
+        live = self.width_live_before(i, live)
+    return count
+
+  # is the branch from block b to block t backward, or so short that it
+  # can take another insn?
+  def short_or_backward(self, b, t):
+    return t.n <= b.n or sum([len(s.insns) for s in self.blocks[b.n+1:t.n]]) <= 16
+
+  # move a rep #$20 before a branch to the fall-through path if the branch
+  # target doesn't need it (the end of a loop, or the skipped sign extension
+  # of a char), and a sep #$20 at the start of a loop before it, so a byte
+  # loop runs in 8-bit mode throughout. The insn only moves to a neighbouring
+  # block, and only a short forward branch can get longer.
+  def move_width_switch(self):
+    self.analyze()
+    self.width_liveness()
+    for b in self.blocks:
+      if b.state is None or [i for i in b.insns if i.cond]: continue
+      # rep #$20 followed only by insns that don't care about the width
+      n = len(b.insns) - 1
+      while n >= 0 and not self.is_width_switch(b.insns[n]) and \
+            (b.insns[n].op is None or b.insns[n].deleted or b.insns[n].op in width_indep):
+        n -= 1
+      if n >= 0 and self.is_width_switch(b.insns[n], 'rep') and not b.exit:
+        last = b.insns[-1]
+        fall = b.n + 1 < len(self.blocks) and self.blocks[b.n + 1]
+        # the successors that need the 16-bit accu
+        need = [s for s in b.succs if s.width_live]
+        if need == [fall] and len(b.succs) == 2 and fall.preds == [b] and \
+           not fall.unknown_preds and not [i for i in fall.insns if i.cond] and \
+           last.op in branches and self.short_or_backward(b, b.succs[0]):
+          b.insns[n].deleted = True
+          k = 0
+          while k < len(fall.insns) and fall.insns[k].op is None: k += 1
+          self.insert(fall, k, 'rep #$20')
+          return 1
+      # sep #$20 preceded only by insns that don't care about the width
+      n = 0
+      while n < len(b.insns) and not self.is_width_switch(b.insns[n]) and \
+            (b.insns[n].op is None or b.insns[n].deleted or b.insns[n].op in width_indep):
+        n += 1
+      if n < len(b.insns) and self.is_width_switch(b.insns[n], 'sep') and \
+         b.n and not b.unknown_preds:
+        prev = self.blocks[b.n - 1]
+        others = [p for p in b.preds if p != prev]
+        if prev in b.preds and prev.succs == [b] and prev.state is not None and \
+           not prev.insns[-1].ends_block() and not [i for i in prev.insns if i.cond] and \
+           others and not [p for p in others if p.state is None or self.width_out(p) != False or \
+                           not self.short_or_backward(p, b)]:
+          b.insns[n].deleted = True
+          self.insert(prev, len(prev.insns), 'sep #$20')
+          return 1
+    return 0
+
+  # a byte load is zero-extended by clearing the accu with 'lda.w #0'
+  # first; if the accu is 8 bits wide already, 'lda.b #0' and 'xba' clear
+  # the high byte without switching to 16 bits and back
+  def clear_high_byte(self):
+    count = 0
+    self.analyze()
+    for b in self.blocks:
+      if b.state is None: continue
+      insns = [(i, m16) for i, m16 in zip(b.insns, self.widths(b)) if not i.deleted and i.op]
+      for n in range(len(insns) - 3):
+        (rep, m16), (clr, _), (sep, _), (load, _) = insns[n:n+4]
+        if m16 == False and self.is_width_switch(rep, 'rep') and \
+           clr.text == 'lda.w #0' and not clr.label and not clr.cond and \
+           self.is_width_switch(sep, 'sep') and load.op == 'lda' and \
+           not load.label and not load.cond:
+          rep.text, rep.op, rep.size, rep.arg = 'lda.b #0', 'lda', 'b', '#0'
+          clr.text, clr.op, clr.size, clr.arg = 'xba', 'xba', '', ''
+          sep.deleted = True
+          count += 1
+    return count
+
+  # WLA sizes an immediate operand without .b or .w by the last sep/rep
+  # before it in the text, not along the control flow; returns the
+  # unsuffixed accu immediates whose width in the text differs from the one
+  # they run at
+  def immediate_width_errors(self):
+    self.analyze()
+    m = {}
+    for b in self.blocks:
+      if b.state is not None: m.update(zip(b.insns, self.widths(b)))
+    errors = set()
+    text_m16 = True
+    for i in self.insns:
+      if i.op is None or i.deleted: continue
+      if i.op in ['rep','sep'] and i.arg in ['#$20','#$30']:
+        if i.cond: text_m16 = None
+        else: text_m16 = i.op == 'rep'
+      elif i.op in ['lda','adc','sbc','and','ora','eor','cmp','bit'] and \
+           not i.size and i.arg.startswith('#') and i in m and m[i] != text_m16:
+        errors.add(i)
+    return errors
+
+  # remove and move accu width switches until nothing changes; if that
+  # changes the width of an unsuffixed immediate, the function keeps its
+  # switches as they were
+  def optimize_widths(self):
+    errors = self.immediate_width_errors()
+    saved = (list(self.insns), [list(b.insns) for b in self.blocks],
+             [(i, i.deleted, i.text, i.op, i.size, i.arg) for i in self.insns])
+    count = 0
+    for n in range(20):
+      c = self.remove_width_switches() + self.move_width_switch()
+      if not c: break
+      count += c
+    count += self.clear_high_byte()
+    if self.immediate_width_errors() - errors:
+      self.insns = saved[0]
+      for b, insns in zip(self.blocks, saved[1]): b.insns = insns
+      for i, deleted, text, op, size, arg in saved[2]:
+        i.deleted, i.text, i.op, i.size, i.arg = deleted, text, op, size, arg
+      return 0
+    return count
+
+  def dump(self):
+    sys.stderr.write('function ' + str(self.name) + '\n')
+    for b in self.blocks:
+      desc = 'B%d' % b.n
+      if b.preds: desc += ' <- ' + ' '.join(['B%d' % p.n for p in b.preds])
+      if b.unknown_preds: desc += ' <- ?'
+      if b.succs: desc += ' -> ' + ' '.join(['B%d' % s.n for s in b.succs])
+      if b.exit: desc += ' -> exit'
+      if b.state:
+        desc += ' [m%s' % {True: '16', False: '8', None: '?'}[b.state[0]]
+        if b.state[1]: desc += ' a=' + b.state[1]
+        for k in sorted(b.state[2]): desc += ' ' + k + '=' + b.state[2][k]
+        desc += ']'
+      else: desc += ' [unreachable]'
+      sys.stderr.write(desc + '\n')
+      for i in b.insns:
+        if not i.deleted: sys.stderr.write('  ' + i.text + '\n')
+
+  def optimize(self):
+    self.analyze()
+    count = self.propagate()
+    self.analyze()
+    count += self.reuse_values()	# leaves the states as they are
+    count += self.eliminate_stores()
+    count += self.optimize_widths()
+    if dump_ir: self.dump()
+    return count
+
+  def lines(self):
+    return [i.text for i in self.insns if not i.deleted]
+
+# run the IR passes on all functions in text
+def optimize_functions(text):
+  out = []
+  count = 0
+  i = 0
+  while i < len(text):
+    out += [text[i]]
+    if text[i].startswith('.section ".text'):
+      j = i + 1
+      while j < len(text) and text[j] != '.ends': j += 1
+      code = [l for l in text[i+1:j] if l]
+      if code and code[0].endswith(':'):
+        f = Function(text[i+1:j])
+        if f.ok:
+          count += f.optimize()
+          out += f.lines()
+          i = j
+          continue
+    i += 1
+  return out, count
+
+
+# helpers for the read/modify/write rules
+
+# 'sym + n' if line is op.w on a variable in .bss, None otherwise
+def bss_operand(line, op):
+  if not line.startswith(op + '.w '): return None
+  arg = line[len(op) + 3:]
+  if arg[0] == '#' or not arg.split(' ')[0] in bss: return None
+  return arg
+
+# value of an immediate operand, None if it isn't a plain number
+def imm_value(arg):
+  try:
+    if arg.startswith('#$'): return int(arg[2:], 16) & 0xffff
+    if arg.startswith('#'): return int(arg[1:]) & 0xffff
+  except ValueError: pass
+  return None
+
+# line index of the target of the branch at line i, None if it isn't in text
+def branch_target(text, i, t):
+  if t and t[0] in '+-' and t == len(t) * t[0]:
+    if t[0] == '+': r = range(i + 1, len(text))
+    else: r = range(i - 1, -1, -1)
+    for j in r:
+      if text[j] == t: return j
+    return None
+  try: return text.index(t + ':')
+  except ValueError: return None
+
+# can p, a pseudo-register or 'a' for the accu, be read on some path from
+# line i on before it is overwritten? With flags, a conditional branch before
+# the accu is reloaded counts as a use, too (it tests the flags set along with
+# the accu).
+def live_at(text, i, p, flags = False, m16 = True, seen = None):
+  if seen is None: seen = set()
+  base = 'tcc__' + p.rstrip('h')
+  while i < len(text):
+    if (i, m16, flags) in seen: return False
+    if len(seen) > 200: return True	# give up
+    seen.add((i, m16, flags))
+    l = text[i].split(';')[0].strip()
+    i += 1
+    if not l or l.endswith(':') or (l[0] in '+-' and l == len(l) * l[0]): continue
+    if l[0] in '+-': return True
+    if l[0] == '.':
+      if l.startswith('.if'):
+        # conditionally assembled; try the way around the block as well
+        depth, j = 1, i
+        while j < len(text) and depth:
+          if text[j].startswith('.if'): depth += 1
+          elif text[j].startswith('.endif'): depth -= 1
+          j += 1
+        if live_at(text, j, p, flags, m16, seen): return True
+      continue
+    f = l.split(' ', 1)
+    op = f[0].split('.')[0]
+    arg = len(f) > 1 and f[1].strip() or ''
+    if op in ['rtl','rts']: return p in ret_pregs
+    if op in ['jsr','jsl']: return arg.startswith('tcc__')	# helpers take pseudo-registers
+    if op in ['rep','sep']:
+      if arg in ['#$20','#$30']: m16 = op == 'rep'
+      elif arg != '#$10': return True
+      continue
+    if op in branches or op in jumps:
+      t = branch_target(text, i - 1, arg)
+      if t is None: return True
+      if op in branches:
+        if p == 'a' and flags: return True
+        if live_at(text, t, p, flags, m16, seen): return True
+      else: i = t
+      continue
+    if p == 'a':
+      if op in ['lda','pla','txa','tya','tdc','tsc']: return not m16
+      if op in ['ldx','ldy','inx','iny','dex','dey','cpx','cpy','plx','ply'] or \
+         (op in ['inc','dec','asl','lsr','rol','ror'] and not arg in ['','a']):
+        flags = False
+        continue
+      if op in ['stx','sty','stz','phx','phy','pea','pei','clc','sec','nop','txy','tyx','tsx','phb','phk','phd']: continue
+      return True
+    if preg_use[p.rstrip('h')].search(arg):
+      if op in write_ops and arg in [base, base + 'h']:
+        if arg != 'tcc__' + p: continue	# the other half
+        if op in ['stx','sty'] or m16: return False
+      return True
+  return True
+
+# x |= y, x &= ~const and single-bit tests of x, with x the .bss variable arg
+# loaded into the accu before line j (as a byte if byte is set): use tsb/trb,
+# or bit and a branch on the flags. Returns the new code and the index of the
+# first line after the old one, or None.
+def lower_rmw(text, j, arg, byte):
+  if not text[j][:6] in ['ora.w ','ora.b ','and.w ']: return None
+  op = text[j][:3]
+  val = text[j][6:]
+  k = j + 1
+  store = None
+  if storeatopseudo.match(text[k]):
+    store = text[k][6:]
+    k += 1
+  if byte: mode = ['sep #$20'], ['rep #$20']
+  else: mode = [], []
+  c = imm_value(val)
+  if c is None:
+    # only pseudo-registers can't alias x
+    if op != 'ora' or not preg_operand.match(val) or '+' in val: return None
+    load = 'lda.b ' + val
+  else:
+    if byte: c &= 0xff
+    load = 'lda' + (byte and '.b' or '.w') + ' #' + str(c)
+
+  if byte: back = ['sep #$20', 'sta.w ' + arg, 'rep #$20']
+  else: back = ['sta.w ' + arg]
+  if text[k:k+len(back)] == back:
+    end = k + len(back)
+    if store and live_at(text, end, store[5:]): return None
+    if live_at(text, end, 'a', True): return None
+    if op == 'ora': return mode[0] + [load, 'tsb.w ' + arg] + mode[1], end
+    if c is None: return None
+    c = ~c & (byte and 0xff or 0xffff)
+    if c == 0: return None	# nothing to clear
+    return mode[0] + ['lda' + (byte and '.b' or '.w') + ' #' + str(c), 'trb.w ' + arg] + mode[1], end
+
+  # if (x & c): the result goes to a pseudo-register that is reloaded to
+  # set the flags
+  if op != 'and' or not c or c & (c - 1) or not store: return None
+  if text[k] != 'lda.b ' + store + " ; DON'T OPTIMIZE" or not text[k+1][:4] in ['bne ','beq ']: return None
+  if live_at(text, k + 1, store[5:]) or live_at(text, k + 1, 'a'): return None
+  branch = text[k+1][4:]
+  top = byte and 0x80 or 0x8000
+  if c == top:
+    # bit copies the top bit of the operand to N...
+    code = ['bit.w ' + arg] + mode[1] + [(text[k+1][:3] == 'bne' and 'bmi ' or 'bpl ') + branch]
+  elif c == top >> 1:
+    # ...and the one below it to V
+    code = ['bit.w ' + arg] + mode[1] + [(text[k+1][:3] == 'bne' and 'bvs ' or 'bvc ') + branch]
+  else:
+    code = [load, 'bit.w ' + arg] + mode[1] + [text[k+1]]
+  return mode[0] + code, k + 2
+
+
+# cost model
+#
+# Size and cycle count of the insn in line, with 16-bit accu and index
+# registers, a page aligned direct page and taken branches; good enough to
+# compare two versions of the same code.
+push_pull_cycles = {'pha':4,'phx':4,'phy':4,'phd':4,'php':3,'phb':3,'phk':3,
+                    'pla':5,'plx':5,'ply':5,'pld':5,'plp':4,'plb':4,
+                    'xba':3,'rtl':6,'rts':6,'rti':7}
+def insn_cost(line):
+  if not line or line[0] in '.;' or line.endswith(':'): return 0, 0
+  line = line.lstrip('+-').split(';')[0].strip()
+  if not line: return 0, 0
+  f = line.split(' ', 1)
+  op = f[0].split('.')[0]
+  size = f[0][len(op)+1:]
+  arg = len(f) > 1 and f[1].strip() or ''
+  if arg in ['', 'a']: return 1, push_pull_cycles.get(op, 2)
+  if op in branches or op == 'bra': return 2, 3
+  if op == 'brl': return 3, 4
+  if op in ['jmp','jml']:
+    if op == 'jml' or size == 'l': return 4, 4
+    return 3, 3
+  if op in ['jsr','jsl']:
+    if op == 'jsl' or size == 'l': return 4, 8
+    return 3, 6
+  if op in ['rep','sep']: return 2, 3
+  if op == 'pea': return 3, 5
+  if op == 'pei': return 2, 6
+  if op in ['mvn','mvp']: return 3, 7
+  if arg[0] == '#':
+    if size == 'b': return 2, 2
+    return 3, 3
+  if arg.endswith(',s'): return 2, 5
+  if arg[0] == '[': return 2, 7
+  if arg[0] == '(': return 2, 6
+  if size == 'b': cost = [2, 4]
+  elif size == 'l': cost = [4, 6]
+  else: cost = [3, 5]
+  if op in ['inc','dec','asl','lsr','rol','ror','tsb','trb']: cost[1] += 3	# read/modify/write
+  if arg.endswith(',x') or arg.endswith(',y'): cost[1] += 1
+  return cost[0], cost[1]
+
+def code_cost(lines):
+  b = c = 0
+  for l in lines:
+    lb, lc = insn_cost(l)
+    b += lb
+    c += lc
+  return b, c
+
+# bytes and cycles saved by replacing old with new, or None if that isn't a
+# win for the goal: the rewrite must not cost cycles (or bytes, for size),
+# and must not cost bytes (cycles) without saving cycles (bytes)
+def rule_gain(old, new):
+  ob, oc = code_cost(old)
+  nb, nc = code_cost(new)
+  return cost_gain(ob - nb, oc - nc)
+
+# the same for code that is gb bytes smaller and gc cycles faster
+def cost_gain(gb, gc):
+  if goal == 'size': gb, gc = gc, gb
+  if gc < 0 or (gc == 0 and gb < 0): return None
+  if goal == 'size': gb, gc = gc, gb
+  return gb, gc
+
+
+# peephole rules
+#
+# peephole(text, i) tries the rules on the lines starting at text[i]. When
+# one of them matches, it returns the lines that replace text[i:end], end
+# and the name of the rule (None for rewrites that only prepare others);
+# None if nothing matches. The rules look at most LOOKAHEAD lines ahead, except for the
+# scans for the next use of a pseudo-register, which stop at the next branch
+# or label.
+#
+# Rules that only look at a fixed window of lines are in the rule file
+# (816-opt.rules, which describes the format) and are matched by
+# match_rules(); the ones that scan ahead, or need more than a pattern, are
+# functions called by peephole(), and named after them. All patterns are
+# compiled here, once.
+
+LOOKAHEAD = 32
+
+# a rule is identified by the name of the function it is written in
+def rule(text_opt, i):
+  return text_opt, i, sys._getframe(1).f_code.co_name
+storetopseudo = re.compile('st([axyz]).b tcc__([rf][0-9]*h?)$')
+storeatopseudo = re.compile('sta.b tcc__([rf][0-9]*h?)$')
+
+# named classes for {name:class} in the rule file
+rule_classes = {
+  'preg': '[rf][0-9]*h?',
+  'dont': "( ; DON'T OPTIMIZE)?",
+}
+
+class Rule:
+  pass
+
+rule_field = re.compile('{([^}]*)}')
+
+# regexp matching a pattern line; names maps the names bound so far to their
+# groups, which get the number of the rule n appended to keep them apart
+# from those of the other rules in the combined regexps
+def rule_line_regexp(line, names, n):
+  r = ''
+  pos = 0
+  for m in rule_field.finditer(line):
+    r += re.escape(line[pos:m.start()])
+    pos = m.end()
+    name, cls = (m.group(1).split(':', 1) + [''])[:2]
+    cls = rule_classes.get(cls, cls) or '.*'
+    # the lines are matched together, a class must not get past the end of
+    # its line
+    cls = re.sub(r'(?<!\\)\[\^', r'[^\\n', cls)
+    if name in names:
+      r += '(?P=%s)' % names[name]
+    elif name:
+      names[name] = '%s_%d' % (name, n)
+      r += '(?P<%s>%s)' % (names[name], cls)
+    else:
+      r += '(?:%s)' % cls
+  return r + re.escape(line[pos:])
+
+# replacement line: a list of literal text and compiled expressions
+def rule_template(line):
+  t = []
+  pos = 0
+  for m in rule_field.finditer(line):
+    t += [line[pos:m.start()]]
+    pos = m.end()
+    expr = m.group(1)
+    if expr.startswith('='): expr = 'str(' + expr[1:] + ')'
+    t += [compile(expr, rules_path, 'eval')]
+  return t + [line[pos:]]
+
+def rule_error(lineno, msg):
+  sys.stderr.write('%s:%d: %s\n' % (rules_path, lineno, msg))
+  sys.exit(1)
+
+rule_name = re.compile('[a-z][a-z0-9_]*$')
+def compile_rule(lines, lineno, n):
+  r = Rule()
+  r.name = None
+  r.lineno = lineno
+  pattern, conds, repl = [], [], None
+  for l in lines:
+    if repl is not None: repl += [rule_template(l)]
+    elif l == '=>': repl = []
+    elif l.startswith('name ') and not pattern and not conds:
+      r.name = l[5:]
+      if not rule_name.match(r.name): rule_error(lineno, 'bad rule name "%s"' % r.name)
+      if r.name in [o.name for o in rules]: rule_error(lineno, 'rule name "%s" used twice' % r.name)
+    elif l.startswith('if '): conds += [compile(l[3:], rules_path, 'eval')]
+    else: pattern += [l]
+  if repl is None: rule_error(lineno, 'no "=>" in rule')
+  if r.name is None: rule_error(lineno, 'no "name" line in rule')
+  if len(pattern) > LOOKAHEAD: rule_error(lineno, 'pattern longer than LOOKAHEAD')
+  r.conds = conds
+  r.repl = repl
+  r.lines = len(pattern)
+  # lines that are replaced, then lines that are only looked at
+  r.length = 0
+  while r.length < len(pattern) and not pattern[r.length][:1] in '&!': r.length += 1
+  if not r.length or [l for l in pattern[r.length:] if not l[:1] in '&!']:
+    rule_error(lineno, 'lines starting with & or ! have to come last')
+  r.names = {}
+  regexp = []
+  # the literal text the rule starts with, for the trie: whole lines, and
+  # the start of the line after them
+  r.prefix = []
+  r.start = None
+  for l in pattern:
+    if l.startswith('!'):
+      regexp += ['(?!(?:%s)(?:\n|$))[^\n]*' % rule_line_regexp(l[1:], r.names, n)]
+      if r.start is None: r.start = ''
+      continue
+    l = l.lstrip('&')
+    regexp += [rule_line_regexp(l, r.names, n)]
+    if r.start is None:
+      if '{' in l: r.start = l.split('{')[0]
+      else: r.prefix += [l]
+  if r.start is None: r.start = ''
+  r.regexp = '(?P<r%d>%s(?=\n|$))' % (n, '\n'.join(regexp))
+  return r
+
+# read the rule file, and build the trie over the prefixes of the rules:
+# each node maps a line to the next node, and None to the starts of the
+# next line with the rules that begin with it
+rules = []
+rule_trie = {}
+rule_lines = []
+for n, l in enumerate(open(rules_path)):
+  l = l.rstrip('\r\n')
+  if l and not (l.startswith('#') and not rule_lines):
+    if not rule_lines: start = n + 1
+    rule_lines += [l]
+  elif rule_lines:
+    rules += [compile_rule(rule_lines, start, len(rules))]
+    rule_lines = []
+if rule_lines: rules += [compile_rule(rule_lines, start, len(rules))]
+for n, r in enumerate(rules):
+  node = rule_trie
+  for l in r.prefix: node = node.setdefault(l, {})
+  node.setdefault(None, {}).setdefault(r.start, []).append(n)
+# the starts as a list of (start, rules) pairs, to go through them quickly
+def rule_trie_finish(node):
+  for k, v in node.items():
+    if k is not None: rule_trie_finish(v)
+  node[None] = node.get(None, {}).items()
+rule_trie_finish(rule_trie)
+
+# The rules that can match at a position are tried with a single regexp,
+# the alternation of their patterns in the order of the file, so the first
+# one that matches is the one that applies. The regexps are built for the
+# sets of rules the trie comes up with as they are needed.
+rule_sets = {}
+def rule_set_regexp(cand):
+  r = rule_sets.get(cand)
+  if not r:
+    r = rule_sets[cand] = (re.compile('|'.join([rules[n].regexp for n in cand])),
+                           max([rules[n].lines for n in cand]))
+  return r
+
+# the rules starting at a line, and the trie node for the lines after it,
+# by line: the same lines come up over and over again
+rule_first = {}
+def rule_first_line(line):
+  r = rule_first.get(line)
+  if not r:
+    r = rule_first[line] = (tuple(sorted([n for start, l in rule_trie[None] if line.startswith(start) for n in l])),
+                            rule_trie.get(line))
+  return r
+
+# applies the first rule in the file that matches at text[i]
+def match_rules(text, i):
+  cand, node = rule_first_line(text[i])
+  more = []
+  j = i + 1
+  while node and j < len(text):
+    for start, n in node[None]:
+      if text[j].startswith(start): more += n
+    node = node.get(text[j])
+    j += 1
+  if more: cand = tuple(sorted(cand + tuple(more)))
+  while cand:
+    regexp, lines = rule_set_regexp(cand)
+    m = regexp.match('\n'.join(text[i:i + lines]))
+    if not m: return None
+    n = int(m.lastgroup[1:])
+    r = rules[n]
+    env = {}
+    for name, group in r.names.items(): env[name] = m.group(group)
+    if not [c for c in r.conds if not eval(c, globals(), env)]:
+      text_opt = []
+      for t in r.repl:
+        line = ''
+        for part in t:
+          if isinstance(part, str): line += part
+          else: line += eval(part, globals(), env)
+        text_opt += [line]
+      return text_opt, i + r.length, r.name
+    # the conditions don't hold, try the rules after this one
+    cand = cand[cand.index(n) + 1:]
+  return None
+
+# two stores to the same preg, or a store right before a function call
+# (which clobbers the pregs anyway) => drop the first store
+def redundant_preg_store(text, i):
+  r = storetopseudo.match(text[i])
+  if not r: return None
+  stores = ['st' + c + '.b tcc__' + r.groups()[1] for c in 'axyz']
+  for j in range(i+1, min(len(text),i+30)):
+    if text[j] in stores:
+      break	# another store to the same pregister
+    if text[j].startswith('jsr.l ') and not text[j].startswith('jsr.l tcc__'):
+      break	# before function call (will be clobbered anyway)
+    # cases in which we don't pursue optimization further
+    if is_control(text[j]) or ('tcc__' + r.groups()[1]) in text[j]: return None # branch or other use of the preg
+    if r.groups()[1].endswith('h') and ('[tcc__' + r.groups()[1].rstrip('h')) in text[j]: return None # use as a pointer
+  else:
+    return None
+  i += 1 # skip redundant store
+  return rule([], i)
+
+# bit manipulation on variables in .bss (absolute addressing only, so this
+# has to wait for the rule file to make the accesses .w)
+def bss_bit_ops(text, i):
+  if text[i] == 'lda.w #0' and text[i+1] == 'sep #$20' and text[i+3] == 'rep #$20':
+    arg, byte, j = bss_operand(text[i+2], 'lda'), True, i + 4
+  else:
+    arg, byte, j = bss_operand(text[i], 'lda'), False, i + 1
+  if not arg: return None
+  r = lower_rmw(text, j, arg, byte)
+  if not r: return None
+  return rule(r[0], r[1])
+
+# don't write preg high back to stack if it hasn't been updated
+def preg_high_writeback(text, i):
+  if text[i+1].endswith('h') and text[i+1].startswith('sta.b tcc__r') and text[i].startswith('lda ') and text[i].endswith(',s'):
+    #sys.stderr.write('checking lines\n')
+    #sys.stderr.write(text[i] + '\n' + text[i+1] + '\n')
+    local = text[i][4:]
+    reg = text[i+1][6:]
+    # lda stack ; store high preg ; ... ; load high preg ; sta stack
+    j = i + 2
+    while j < len(text) - 2 and not is_control(text[j]) and not reg in text[j]:
+      j += 1
+    if text[j] == 'lda.b ' + reg and text[j+1] == 'sta ' + local:
+      text_opt = text[i:j]
+      i = j + 2 # skip load high preg ; sta stack
+      return rule(text_opt, i)
+  return None
+
+# reorder copying of 32-bit value to preg if it looks as if that could
+# allow further optimization
+# looking for
+#   lda something
+#   sta.b tcc_rX
+#   lda something
+#   sta.b tcc_rYh
+#   ...tcc_rX...
+def reorder_copy32(text, i):
+  if text[i].startswith('lda') and text[i+1].startswith('sta.b tcc__r'):
+    reg = text[i+1][6:]
+    if not reg.endswith('h') and \
+       text[i+2].startswith('lda') and not text[i+2].endswith(reg) and \
+       text[i+3].startswith('sta.b tcc__r') and text[i+3].endswith('h') and \
+       text[i+4].endswith(reg):
+      text_opt = [text[i+2], text[i+3], text[i], text[i+1]]
+      i += 4
+      # this is not an optimization per se, so we don't count it
+      return text_opt, i, None
+  return None
+
+# jump to the label right after it => drop the jump
+def jump_to_next(text, i):
+  if text[i].startswith('jmp.w ') or text[i].startswith('bra __'):
+    j = i + 1
+    while j < len(text) and text[j].endswith(':'):
+      if text[i].endswith(text[j][:-1]):
+        # redundant branch, discard it
+        return rule([], i + 1)
+      j += 1
+  return None
+
+def peephole(text, i):
+  r = redundant_preg_store(text, i) or match_rules(text, i)
+  if not r and text[i].startswith('ld'):
+    r = bss_bit_ops(text, i) or preg_high_writeback(text, i) or reorder_copy32(text, i)
+  return r or jump_to_next(text, i)
+
+# The rules used to be run over the whole file until nothing changed. A
+# rewrite can only enable rules whose window reaches the changed lines,
+# though, so now only those lines are tried again: peephole_pass() goes over
+# the lines marked in todo, and after each rewrite marks the lines up to
+# LOOKAHEAD before and after it for the next pass. The first pass does all
+# the work of the old one, and the passes after it are cheap.
+#
+# Rewrites that make the code worse for the goal are skipped; stats holds
+# how often each rule was applied and skipped, and the bytes and cycles it
+# saved.
+stats = {}	# of the file being optimized
+def peephole_pass(text, todo):
+  count = 0
+  i = 0
+  while i < len(text):
+    if not todo[i]:
+      i += 1
+      continue
+    todo[i] = False
+    r = peephole(text, i)
+    if not r:
+      i += 1
+      continue
+    if r[2]:
+      gain = rule_gain(text[i:r[1]], r[0])
+      st = stats.setdefault(str(r[2]), [0, 0, 0, 0])
+      if gain is None:
+        st[1] += 1
+        i += 1
+        continue
+      st[0] += 1
+      st[2] += gain[0]
+      st[3] += gain[1]
+    text[i:r[1]] = r[0]
+    todo[i:r[1]] = [False] * len(r[0])
+    end = i + len(r[0])
+    for k in range(max(0, i - LOOKAHEAD), min(len(text), end + LOOKAHEAD)):
+      todo[k] = True
+    if r[2]: count += 1
+    i = end
+  return count
+
+
+# block moves
+#
+# tcc compiles a loop copying one array to another, or filling one with
+# constants, into code that builds the pointers to the elements anew in
+# every iteration: a hundred cycles and more per byte. block_moves() finds
+# such loops in the code as it comes from the compiler, before anything
+# else touches it, and replaces them with an mvn through move_insn in
+# crt0_snes.asm, at 7 cycles per byte, the way memcpy() in libc.asm does.
+# A fill stores the first period of the pattern, and mvn copies it over
+# the rest with the destination one period ahead of the source.
+#
+# The loop has to look like "for (i = K; i < N; i += step)" with constant
+# K, N and step, a 16-bit counter and a body without control flow that does
+# nothing but stores to the elements of one array (one that is named, so
+# it can't overlap the source) at indices derived from i.
+#
+# move_insn is shared with memcpy() and memmove(). The banks of a copy sit
+# in it until mvn is done, and an interrupt can stop mvn in the middle and
+# let it go on afterwards; an interrupt handler that copies memory through
+# move_insn in the meantime leaves its banks there, and the interrupted
+# copy goes on between the wrong banks. So loops in interrupt handlers
+# (the functions ending in rti) are left as they are. A handler calling
+# memcpy() or memmove() still breaks a block move it interrupts, as it
+# does a memcpy().
+
+# the loop condition (i < N on an unsigned or signed counter), followed by
+# the label of the increment
+bm_cond = ['lda (?P<s>.*),s', 'sta.b tcc__(?P<p>r[0-9]+)', 'ldx #1', 'lda.b tcc__(?P=p)',
+           'sec', 'sbc.w #(?P<n>[0-9]+)', 'tay', '(?P<cmp>%s)',
+           'stx.b tcc__(?P<q>r[0-9]+)', "lda.b tcc__(?P=q) ; DON'T OPTIMIZE",
+           'bne \+', 'brl (?P<exit>\S+)', '\+', 'jmp.w (?P<body>\S+)', '(?P<inc>\S+):']
+bm_cond_unsigned = re.compile('\n'.join(bm_cond) % 'bcc \+\+\n\+ dex\n\+\+')
+bm_cond_signed = re.compile('\n'.join(bm_cond) % 'bvc \+\neor #\$8000\n\+\nbmi \+\+\+\n\+\+\ndex\n\+\+\+')
+bm_cond_lines = [len(bm_cond) + 2, len(bm_cond) + 6]
+# the initialization of the counter, in the lines before the condition
+bm_init = re.compile('lda.w #(?P<k>[0-9]+)\nsta.b tcc__(?P<p>r[0-9]+)\nlda.b tcc__(?P=p)\nsta (?P<s>.*),s$')
+bm_imm_sym = re.compile('#([A-Za-z_][A-Za-z0-9_]*) \+ (-?[0-9]+)$')
+bm_imm_bank = re.compile('#:([A-Za-z_][A-Za-z0-9_]*)$')
+
+# The body is run symbolically. Values are ('lin', sym, off, coef) for the
+# address of sym (None for a number) + off + coef * i, ('bank', sym),
+# ('mem', width, address) for what a load got from memory, ('lo', value)
+# for a word of which only the low byte (one of the former) is known, and
+# None if they are unknown.
+def bm_wrap(off):
+  return ((off + 0x8000) & 0xffff) - 0x8000
+
+def bm_const(c):
+  return ('lin', None, bm_wrap(c), 0)
+
+def bm_add(a, b):
+  if not a or not b or a[0] != 'lin' or b[0] != 'lin' or (a[1] and b[1]): return None
+  return ('lin', a[1] or b[1], bm_wrap(a[2] + b[2]), a[3] + b[3])
+
+def bm_shift(a):
+  if not a or a[0] != 'lin' or a[1]: return None
+  return ('lin', None, bm_wrap(a[2] * 2), a[3] * 2)
+
+def bm_low(v):
+  if not v: return None
+  if v[0] == 'lo': return v[1]
+  if v[0] == 'lin' and not v[1] and not v[3]: return bm_const(v[2] & 0xff)
+  if v[0] == 'mem': return ('mem', 1, v[2])
+  return None
+
+# the address in the long pointer in preg p, if it points into an array
+def bm_pointer(regs, p):
+  a, bank = regs.get(p), regs.get(p + 'h')
+  if not a or a[0] != 'lin' or not a[1] or bank != ('bank', a[1]): return None
+  return a
+
+# Runs code with the counter i in the stack slot at offset s. Returns the
+# stores to memory as (width, address, value) and the value left in the
+# counter, or None if the code does anything else.
+def bm_run(code, s):
+  acc = None
+  m8 = False
+  carry = None
+  regs = {}
+  stores = []
+  counter = ('lin', None, 0, 1)
+  for l in code:
+    f = l.split(' ', 1)
+    op = f[0]
+    arg = len(f) > 1 and f[1] or ''
+    if op in ['sep','rep']:
+      if arg != '#$20': return None
+      m8 = op == 'sep'
+      continue
+    if op in ['clc','sec']:
+      carry = op == 'sec'
+      continue
+    if m8 and not op in ['lda.b','sta.b'] or arg.startswith('#') and op != 'adc.w' and op != 'lda.w' or \
+       ';' in arg:
+      return None
+    preg = preg_operand.match(arg)
+    if preg and '+' in arg: return None
+    ind = preg_indirect.match(arg)
+    if ind and ind.group(2): return None
+    if op == 'lda' and arg == s + ',s': acc = counter
+    elif op == 'sta' and arg == s + ',s': counter = acc
+    elif op == 'lda.w':
+      c = imm_value(arg)
+      m = bm_imm_sym.match(arg)
+      b = bm_imm_bank.match(arg)
+      if c is not None: acc = bm_const(c)
+      elif m: acc = ('lin', m.group(1), bm_wrap(int(m.group(2))), 0)
+      elif b: acc = ('bank', b.group(1))
+      else: return None
+    elif op == 'lda.b' and preg:
+      acc = regs.get(preg.group(1))
+      if m8:
+        acc = bm_low(acc)
+        acc = acc and ('lo', acc)
+    elif op == 'sta.b' and preg:
+      regs[preg.group(1)] = not m8 and acc or None
+    elif op in ['inc.b','dec.b'] and preg:
+      regs[preg.group(1)] = bm_add(regs.get(preg.group(1)), bm_const(op == 'inc.b' and 1 or -1))
+    elif op == 'asl.b' and preg:
+      regs[preg.group(1)] = bm_shift(regs.get(preg.group(1)))
+      carry = None
+    elif op == 'asl' and arg == 'a':
+      acc = bm_shift(acc)
+      carry = None
+    elif op in ['adc.b','adc.w']:
+      if carry != False: return None
+      if preg: acc = bm_add(acc, regs.get(preg.group(1)))
+      elif imm_value(arg) is not None: acc = bm_add(acc, bm_const(imm_value(arg)))
+      else: return None
+      carry = None
+    elif op in ['lda.b','sta.b'] and ind:
+      a = bm_pointer(regs, ind.group(1))
+      if not a: return None
+      if op == 'lda.b':
+        if m8: acc = ('lo', ('mem', 1, a))
+        else: acc = ('mem', 2, a)
+      elif m8:
+        v = bm_low(acc)
+        if not v: return None
+        stores += [(1, a, v)]
+      else:
+        if not acc or not (acc[0] == 'mem' or acc[0] == 'lin' and not acc[1] and not acc[3]): return None
+        stores += [(2, a, acc)]
+    else: return None
+  if m8: return None
+  return stores, counter
+
+# The bytes the stores write in one iteration, relative to the first one,
+# as (array, start, stride) and a list with a constant or the source
+# address (sym, off) for each byte; None if they don't form a contiguous
+# block advancing by the number of bytes written per iteration, step being
+# the increment of i.
+def bm_block(stores, step):
+  if not stores: return None
+  sym, coef = stores[0][1][1], stores[0][1][3]
+  written = {}
+  for w, a, v in stores:
+    if a[1] != sym or a[3] != coef: return None
+    for n in range(w):
+      if a[2] + n in written: return None
+      if v[0] == 'lin': written[a[2] + n] = (v[2] >> (8 * n)) & 0xff
+      elif v[2][3] != coef or v[2][1] == sym: return None
+      else: written[a[2] + n] = (v[2][1], v[2][2] + n)
+  start = min(written)
+  if coef <= 0 or sorted(written) != range(start, start + coef * step): return None
+  return (sym, start, coef), [written[n] for n in range(start, start + coef * step)]
+
+def bm_at(sym, off):
+  if off < 0: return '%s - %d' % (sym, -off)
+  return '%s + %d' % (sym, off)
+
+def bm_loop(text, c):
+  if c < 4 or not text[c].endswith(':'): return None
+  code = '\n'.join(text[c + 1:c + 1 + bm_cond_lines[0]])
+  m = bm_cond_unsigned.match(code)
+  signed = False
+  if not m:
+    m = bm_cond_signed.match('\n'.join(text[c + 1:c + 1 + bm_cond_lines[1]]))
+    signed = True
+  if not m: return None
+  init = bm_init.match('\n'.join(text[c - 4:c]))
+  if not init or init.group('s') != m.group('s'): return None
+  s, label = m.group('s'), text[c][:-1]
+  # the increment, then the body, then the end of the loop
+  i = c + 1 + bm_cond_lines[signed]
+  j = i
+  while j < len(text) and not is_control(text[j]): j += 1
+  if j + 1 >= len(text) or text[j] != 'jmp.w ' + label or text[j + 1] != m.group('body') + ':': return None
+  k = j + 2
+  while k < len(text) and not is_control(text[k]): k += 1
+  if k + 1 >= len(text) or text[k] != 'jmp.w ' + m.group('inc') or text[k + 1] != m.group('exit') + ':':
+    return None
+  # nothing else may go to the loop's labels
+  for l in [label, m.group('inc'), m.group('body')]:
+    if len([t for t in text if t.endswith(' ' + l)]) != 1: return None
+
+  inc = bm_run(text[i:j], s)
+  body = bm_run(text[j + 2:k], s)
+  if not inc or not body or inc[0] or body[1] != ('lin', None, 0, 1): return None
+  step = inc[1]
+  if not step or step[0] != 'lin' or step[1] or step[3] != 1 or step[2] <= 0: return None
+  step = step[2]
+  block = bm_block(body[0], step)
+  if not block: return None
+
+  first, last = int(init.group('k')), int(m.group('n'))
+  if signed and (first >= 0x8000 or last >= 0x8000): return None
+  trips = (last - first + step - 1) // step
+  end = first + trips * step
+  if trips < 2 or end > (signed and 0x7fff or 0xffff): return None
+  (sym, start, coef), period = block
+  size = trips * len(period)
+  if size > 0x10000: return None
+  dst = bm_at(sym, start + coef * first)
+  if not [b for b in period if not isinstance(b, int)]:
+    # fill: the first period, then copy it along
+    new = []
+    n = 0
+    while n < len(period):
+      at = bm_at(sym, start + coef * first + n)
+      if n + 1 < len(period):
+        load = 'lda.w #' + str(period[n] + 256 * period[n + 1])
+        if not load in new[-2:]: new += [load]
+        new += ['sta.l ' + at]
+        n += 2
+      else:
+        new += ['sep #$20', 'lda.b #' + str(period[n]), 'sta.l ' + at, 'rep #$20']
+        n += 1
+    src, dst, count = dst, bm_at(sym, start + coef * first + len(period)), size - len(period)
+    banks = [sym, sym]
+  else:
+    if isinstance(period[0], int): return None
+    src_sym = period[0][0]
+    if [b for n, b in enumerate(period) if b != (src_sym, period[0][1] + n)]: return None
+    new = []
+    src, count = bm_at(src_sym, period[0][1] + coef * first), size
+    banks = [src_sym, sym]
+  new += ['lda.w #:' + banks[0], 'xba', 'ora.w #:' + banks[1], 'sta.b move_insn + 1',
+          'ldx.w #' + src, 'ldy.w #' + dst, 'lda.w #' + str(count - 1),
+          'phb', 'jsr move_insn', 'plb', 'lda.w #' + str(end), 'sta ' + s + ',s']
+
+  # the loop runs the condition once more than the rest
+  old = text[c - 4:k + 1]
+  ob, oc = code_cost(text[c - 4:c])
+  cond, rest = code_cost(text[c + 1:i]), code_cost(text[i:k + 1])
+  ob += cond[0] + rest[0]
+  oc += (trips + 1) * cond[1] + trips * rest[1]
+  nb, nc = code_cost(new)
+  gain = cost_gain(ob - nb, oc - nc - 7 * count)	# mvn takes 7 cycles per byte
+  if not gain: return None
+  return new, c - 4, k + 1, gain
+
+def block_moves(text):
+  count = 0
+  c = 4
+  while c < len(text):
+    if text[c].startswith('.section '):
+      # skip interrupt handlers
+      e = c
+      while e < len(text) and text[e] != '.ends': e += 1
+      if 'rti' in text[c:e]:
+        c = e
+        continue
+    r = bm_loop(text, c)
+    if not r:
+      c += 1
+      continue
+    new, start, end, gain = r
+    if stats_to:
+      st = stats.setdefault('moves', [0, 0, 0, 0])
+      st[0] += 1
+      st[2] += gain[0]
+      st[3] += gain[1]
+    text[start:end] = new
+    c = start + len(new)
+    count += 1
+  return count
+
+
+# branch shortening
+#
+# Once the code is final, jmp.w and brl become bra, and the branch around
+# a brl that the compiler emits for conditional jumps ("b<cc> +", "brl
+# label", "+") becomes a single b<!cc>, wherever the target is in reach of
+# a short branch. The addresses are computed from the size of every insn;
+# where that isn't known for sure, the largest one is used, so distances
+# never come out too short. Converting a branch only brings the others
+# closer to their targets, so this is repeated until nothing changes.
+
+inverse_branch = {'bcc':'bcs','bcs':'bcc','beq':'bne','bne':'beq',
+                  'bmi':'bpl','bpl':'bmi','bvc':'bvs','bvs':'bvc'}
+
+# size of the insn in line (0 for labels and conditional assembly, whose
+# code is counted as if it was assembled), None for other directives: code
+# in different sections may end up anywhere
+def insn_size(line):
+  if line.startswith('.'):
+    if line.split(' ')[0] in ['.ifgr','.ifeq','.ifneq','.ifdef','.ifndef','.else','.endif']: return 0
+    return None
+  size = insn_cost(line)[0]
+  arg = line.lstrip('+-').split(';')[0].strip().split(' ', 1)
+  if size == 3 and len(arg) > 1 and not '.' in arg[0] and arg[1][0] not in '#([' and \
+     not arg[0] in jumps and not arg[0] in ['pea','mvn','mvp']:
+    size = 4	# no size given, could be a long address
+  return size
+
+# the target of a jump or branch in reach of a short one; the new branch
+# takes the place of the lines text[i:i + n]
+def short_target(text, i, n, label, addr, area, labels):
+  t = labels.get(label)
+  if t is None or area[t] != area[i]: return False
+  if t > i: d = addr[t] - (addr[i] + sum([insn_size(l) for l in text[i:i + n]]))
+  else: d = addr[t] - (addr[i] + 2)
+  return -128 <= d <= 127
+
+def shorten_branches(text):
+  count = 0
+  while True:
+    # addresses, and the areas without directives in between
+    addr, area, labels = [], [], {}
+    a = areas = 0
+    for k, l in enumerate(text):
+      size = insn_size(l)
+      if size is None:
+        areas += 1
+        size = 0
+      addr += [a]
+      area += [areas]
+      a += size
+      if l.endswith(':'): labels[l[:-1]] = k
+    new = []
+    changed = False
+    i = 0
+    while i < len(text):
+      l = text[i]
+      f = l.split(' ')
+      old = None
+      if f[0] in ['jmp.w','brl'] and len(f) == 2 and \
+         short_target(text, i, 1, f[1], addr, area, labels):
+        old, n = text[i:i + 1], 1
+        repl = ['bra ' + f[1]]
+      elif f[0] in inverse_branch and f[1:] == ['+'] and i + 2 < len(text) and \
+           text[i + 1].startswith('brl ') and text[i + 2] == '+' and \
+           short_target(text, i, 2, text[i + 1][4:], addr, area, labels):
+        # the + stays, other branches may go there
+        old, n = text[i:i + 2], 2
+        repl = [inverse_branch[f[0]] + ' ' + text[i + 1][4:]]
+      if old:
+        if stats_to:
+          gain = rule_gain(old, repl)
+          st = stats.setdefault('branches', [0, 0, 0, 0])
+          st[0] += 1
+          st[2] += gain[0]
+          st[3] += gain[1]
+        new += repl
+        i += n
+        count += 1
+        changed = True
+      else:
+        new += [l]
+        i += 1
+    if not changed: return count
+    text[:] = new
+
+
+# optimizes the assembler file name, returns the lines of the result
+def optimize_file(name):
+  global bss, stats
+  text = read_ps(name)
+  bss = find_bss(text)
+  stats = {}
+
+  opted = -1	# have we optimized in this pass?
+  opass = 0	# optimization pass counter
+  irpass = 0	# IR pass counter
+  totalopt = block_moves(text)	# total number of optimizations performed
+  note('block moves: ' + str(totalopt) + ' loops replaced')
+  todo = [True] * len(text)	# lines the rules have to look at
+  while opted:
+    opass += 1
+    opted = peephole_pass(text, todo)
+    note('optimization pass ' + str(opass) + ': ' + str(opted) + ' optimizations performed')
+    totalopt += opted
+    if not opted and irpass < 10:
+      # the peephole rules are done; see if the IR passes find anything, and
+      # go over the result again if they do
+      irpass += 1
+      before = stats_to and code_cost(text)
+      text, opted = optimize_functions(text)
+      todo = [True] * len(text)
+      if stats_to:
+        after = code_cost(text)
+        st = stats.setdefault('IR', [0, 0, 0, 0])
+        st[0] += opted
+        st[2] += before[0] - after[0]
+        st[3] += before[1] - after[1]
+      note('IR pass ' + str(irpass) + ': ' + str(opted) + ' optimizations performed')
+      totalopt += opted
+
+  opted = shorten_branches(text)
+  note('branch shortening: ' + str(opted) + ' branches shortened')
+  totalopt += opted
+
+  note(str(totalopt) + ' optimizations performed in total')
+  if stats_to == '1': print_stats(stats, sys.stderr)
+  elif stats_to:
+    out = ''
+    for k, v in stats.items(): out += '%s %d %d %d %d\n' % (k, v[0], v[1], v[2], v[3])
+    f = open(stats_to, 'a')
+    f.write(out)	# in one go, for parallel builds
+    f.close()
+  return text
+
+
+# batch mode
+#
+# 816-opt.py --batch [-j jobs] [-u] in.ps out.asm [in.ps out.asm...]
+#
+# optimizes the files in.ps to out.asm, in jobs worker processes (one per
+# core by default) that share the rules compiled here. That saves starting
+# Python and compiling the rules for every file; the output is the same as
+# that of 816-opt.py in.ps >out.asm. With -u, only the files whose output
+# is missing or older than the input are done, like make would.
+
+def batch_job(job):
+  global note_prefix
+  ps, asm = job
+  note_prefix = ps + ': '
+  try:
+    text = optimize_file(ps)
+    f = open(asm, 'w')
+    for l in text: f.write(l + '\n')
+    f.close()
+  except Exception:
+    return ps + ': ' + traceback.format_exc()
+  return None
+
+def batch(args):
+  usage = 'usage: 816-opt.py --batch [-j jobs] [-u] in.ps out.asm [in.ps out.asm...]\n'
+  try: opts, files = getopt.getopt(args, 'j:u')
+  except getopt.GetoptError:
+    sys.stderr.write(usage)
+    return 1
+  jobs = None
+  update = False
+  for o, a in opts:
+    if o == '-j': jobs = int(a)
+    elif o == '-u': update = True
+  if len(files) % 2:
+    sys.stderr.write(usage)
+    return 1
+  pairs = zip(files[0::2], files[1::2])
+  if update:
+    pairs = [(ps, asm) for ps, asm in pairs
+             if not os.path.exists(asm) or os.path.getmtime(asm) < os.path.getmtime(ps)]
+  if jobs == 1 or len(pairs) < 2:
+    errors = map(batch_job, pairs)
+  else:
+    import multiprocessing
+    pool = multiprocessing.Pool(jobs)
+    # get() with a timeout, without one ^C isn't seen until the end
+    errors = pool.map_async(batch_job, pairs, 1).get(1 << 30)
+    pool.close()
+    pool.join()
+  errors = [e for e in errors if e]
+  for e in errors: sys.stderr.write(e)
+  return errors and 1 or 0
+
+
+if __name__ == '__main__':
+  if len(sys.argv) > 2 and sys.argv[1] == '--stats':
+    stats = {}
+    for l in open(sys.argv[2]):
+      f = l.split()
+      v = stats.setdefault(f[0], [0, 0, 0, 0])
+      for n in range(4): v[n] += int(f[n+1])
+    print_stats(stats, sys.stdout)
+  elif len(sys.argv) > 1 and sys.argv[1] == '--batch':
+    sys.exit(batch(sys.argv[2:]))
+  else:
+    for l in optimize_file(sys.argv[1]): print l
+
+#prof.stop()
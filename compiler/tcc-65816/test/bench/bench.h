@@ -0,0 +1,6 @@
+/* Benchmark harness. The simulator (tools/snesim) counts the cycles
+   spent between BENCH_START() and BENCH_STOP(); main() returns 0 when
+   the kernel computed the expected result. */
+#define BENCH_TIMER (*(volatile unsigned char *)0xfffc)
+#define BENCH_START() (BENCH_TIMER = 1)
+#define BENCH_STOP() (BENCH_TIMER = 0)
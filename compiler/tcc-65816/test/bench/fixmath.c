@@ -0,0 +1,73 @@
+/* 8.8 fixed-point math: rotate and scale a set of points */
+#include "bench.h"
+
+#define POINTS 32
+
+typedef int fixed;
+
+/* sin(i * 2pi / 64) in 8.8 for the first quadrant */
+const fixed sin_table[17] = {
+  0, 25, 50, 74, 98, 121, 142, 162, 181, 198, 213, 226, 237, 245, 251, 255,
+  256
+};
+
+fixed px[POINTS], py[POINTS], rx[POINTS], ry[POINTS];
+
+fixed fmul(fixed a, fixed b)
+{
+  return ((long long)a * b) >> 8;
+}
+
+fixed fdiv(fixed a, fixed b)
+{
+  return ((long long)a << 8) / b;
+}
+
+fixed fsin(int angle)
+{
+  angle &= 63;
+  if (angle < 16)
+    return sin_table[angle];
+  if (angle < 32)
+    return sin_table[32 - angle];
+  if (angle < 48)
+    return -sin_table[angle - 32];
+  return -sin_table[64 - angle];
+}
+
+void rotate(int angle, fixed scale)
+{
+  fixed s = fmul(fsin(angle), scale), c = fmul(fsin(angle + 16), scale);
+  int i;
+
+  for (i = 0; i < POINTS; i++) {
+    rx[i] = fmul(px[i], c) - fmul(py[i], s);
+    ry[i] = fmul(px[i], s) + fmul(py[i], c);
+  }
+}
+
+int main(void)
+{
+  int i, angle;
+  fixed scale = 256;
+
+  for (i = 0; i < POINTS; i++) {
+    px[i] = (i - 16) << 8;
+    py[i] = (i & 7) << 8;
+  }
+
+  BENCH_START();
+  for (angle = 0; angle < 16; angle++) {
+    rotate(angle, scale);
+    scale = fdiv(scale, 300);
+    scale = fmul(scale, 300) + 1;
+  }
+  BENCH_STOP();
+
+  /* a quarter turn rotates (x, y) to (-y, x) */
+  rotate(16, 256);
+  for (i = 0; i < POINTS; i++)
+    if (rx[i] != -py[i] || ry[i] != px[i])
+      return 1;
+  return 0;
+}
@@ -0,0 +1,42 @@
+/* memcpy-style loops: bytes, words and the libc memcpy */
+#include <string.h>
+#include "bench.h"
+
+#define SIZE 512
+
+unsigned char src[SIZE], dst[SIZE];
+
+void copy_bytes(unsigned char *d, unsigned char *s, int n)
+{
+  while (n--)
+    *d++ = *s++;
+}
+
+void copy_words(unsigned int *d, unsigned int *s, int n)
+{
+  int i;
+  for (i = 0; i < n; i++)
+    d[i] = s[i];
+}
+
+int main(void)
+{
+  unsigned int sum;
+  int i;
+
+  for (i = 0; i < SIZE; i++)
+    src[i] = i * 7;
+
+  BENCH_START();
+  for (i = 0; i < 4; i++) {
+    copy_bytes(dst, src, SIZE);
+    copy_words((unsigned int *)dst, (unsigned int *)src, SIZE / 2);
+    memcpy(dst, src, SIZE);
+  }
+  BENCH_STOP();
+
+  sum = 0;
+  for (i = 0; i < SIZE; i++)
+    sum += dst[i];
+  return sum != 65280;
+}
@@ -0,0 +1,226 @@
+#!/usr/bin/env python
+# Cycle count benchmarks for the code generated by 816-tcc and 816-opt.py.
+#
+# Every kernel (*.c in this directory) is compiled, optimized, assembled,
+# linked with the runtime and run under tools/snesim. The cycles spent
+# between BENCH_START() and BENCH_STOP() and the size of the kernel's code
+# are written to bench.out, one "kernel cycles bytes" line per kernel, and
+# compared against the checked-in baseline: a kernel that got slower or
+# bigger by more than the threshold, or that is missing from the baseline,
+# makes run.py exit with 1.
+#
+# usage: run.py [-u] [-t percent] [-o file] [kernel...]
+#   -u          record the results as the new baseline
+#   -t percent  allowed growth before a kernel counts as a regression (2)
+#   -o file     results file (bench.out)
+#
+# Tools can be overridden from the environment: TCC, OPT, PYTHON, AS, LD,
+# SNESIM, INCLUDE, HDR and LIBDIR. OPTIMIZE=0 skips 816-opt.py and
+# NOCLEAN=1 keeps the build directory.
+
+from __future__ import print_function
+import getopt
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+here = os.path.dirname(os.path.abspath(__file__))
+top = os.path.join(here, '..', '..', '..', '..')
+
+
+def tool(name, default):
+  return os.environ.get(name, default)
+
+
+TCC = tool('TCC', os.path.join(here, '..', '..', '816-tcc'))
+OPT = tool('OPT', os.path.join(here, '..', '..', '816-opt.py'))
+PYTHON = tool('PYTHON', 'python')
+AS = tool('AS', 'wla-65816')
+LD = tool('LD', 'wlalink')
+SNESIM = tool('SNESIM', 'snesim')
+INCLUDE = tool('INCLUDE', os.path.join(top, 'devkitsnes', 'include'))
+HDR = tool('HDR', os.path.join(top, 'devkitsnes', 'include', 'hdr.asm'))
+LIBDIR = tool('LIBDIR', os.path.join(top, 'pvsneslib', 'lib'))
+LIBS = ['crt0_snes.obj', 'libm.obj', 'libtcc.obj', 'libc.obj']
+
+BASELINE = os.path.join(here, 'baseline')
+
+
+class BenchError(Exception):
+  pass
+
+
+def run(cmd, cwd, stdout=None):
+  p = subprocess.Popen(cmd, cwd=cwd, stdout=stdout or subprocess.PIPE,
+                       stderr=subprocess.STDOUT)
+  out = p.communicate()[0]
+  if p.returncode:
+    raise BenchError('%s failed:\n%s' % (os.path.basename(cmd[0]),
+                                          out and out.decode('latin-1') or ''))
+  return out and out.decode('latin-1') or ''
+
+
+# functions defined by a generated .asm file, and the local labels inside
+# them
+def asm_labels(asm):
+  funcs, inner = [], set()
+  text = False
+  for line in open(asm):
+    if line.startswith('.section'):
+      text = line.startswith('.section ".text')
+    m = re.match(r'^([A-Za-z_][A-Za-z0-9_.]*):', line)
+    if m and text:
+      if m.group(1).startswith('__local_'):
+        inner.add(m.group(1))
+      else:
+        funcs.append(m.group(1))
+  return funcs, inner
+
+
+# label -> 24 bit address from a wlalink symbol file
+def sym_labels(sym):
+  syms = {}
+  section = None
+  for line in open(sym):
+    line = line.strip()
+    if line.startswith('['):
+      section = line
+      continue
+    m = re.match(r'^([0-9a-fA-F]+):?([0-9a-fA-F]{4}):?\s+(\S+)$', line)
+    if m and section == '[labels]':
+      syms[m.group(3)] = (int(m.group(1), 16) << 16) | int(m.group(2), 16)
+  return syms
+
+
+# code size of the kernel's functions: the distance from each function to
+# the next label that is not inside it
+def code_bytes(asm, sym):
+  funcs, inner = asm_labels(asm)
+  syms = sym_labels(sym)
+  bounds = sorted(a for n, a in syms.items() if n not in inner)
+  size = 0
+  for f in funcs:
+    if f not in syms:
+      continue
+    start = syms[f]
+    end = (start | 0xffff) + 1
+    for a in bounds:
+      if a > start:
+        end = min(end, a)
+        break
+    size += end - start
+  return size
+
+
+def bench(kernel, work):
+  name = os.path.splitext(os.path.basename(kernel))[0]
+  ps = name + '.ps'
+  asm = name + '.asm'
+  run([TCC, '-I' + INCLUDE, '-DSTACK_SIZE=0x2000', '-o', ps,
+       '-c', kernel], work)
+  if os.environ.get('OPTIMIZE', '1') != '0':
+    env = os.environ.copy()
+    env['OPT816_QUIET'] = '1'
+    out = open(os.path.join(work, asm), 'w')
+    p = subprocess.Popen([PYTHON, OPT, ps], cwd=work, stdout=out, env=env)
+    p.communicate()
+    out.close()
+    if p.returncode:
+      raise BenchError('816-opt.py failed')
+  else:
+    shutil.copy(os.path.join(work, ps), os.path.join(work, asm))
+  run([AS, '-io', asm, name + '.obj'], work)
+  run([LD, '-dsnov', name + '.obj'] +
+      [os.path.join(LIBDIR, l) for l in LIBS] + [name + '.sfc'], work)
+  out = run([SNESIM, name + '.sfc'], work).strip()
+  m = re.search(r'bench=(\d+)', out)
+  if not out.startswith('PASS') or not m:
+    raise BenchError(out)
+  return int(m.group(1)), code_bytes(os.path.join(work, asm),
+                                     os.path.join(work, name + '.sym'))
+
+
+def read_results(path):
+  results = {}
+  for line in open(path):
+    f = line.split()
+    if len(f) == 3 and not line.startswith('#'):
+      results[f[0]] = (int(f[1]), int(f[2]))
+  return results
+
+
+def write_results(path, results):
+  out = open(path, 'w')
+  out.write('# kernel cycles bytes\n')
+  for name in sorted(results):
+    out.write('%s %d %d\n' % (name, results[name][0], results[name][1]))
+  out.close()
+
+
+def main():
+  update = False
+  threshold = 2.0
+  output = os.path.join(here, 'bench.out')
+  opts, args = getopt.getopt(sys.argv[1:], 'ut:o:')
+  for o, a in opts:
+    if o == '-u':
+      update = True
+    elif o == '-t':
+      threshold = float(a)
+    elif o == '-o':
+      output = a
+  kernels = args or sorted(glob.glob(os.path.join(here, '*.c')))
+
+  work = tempfile.mkdtemp(prefix='bench')
+  shutil.copy(HDR, os.path.join(work, 'hdr.asm'))
+  results = {}
+  failed = False
+  try:
+    for k in kernels:
+      name = os.path.splitext(os.path.basename(k))[0]
+      try:
+        results[name] = bench(os.path.abspath(k), work)
+      except BenchError as e:
+        print('%s: FAIL %s' % (name, e))
+        failed = True
+  finally:
+    if not os.environ.get('NOCLEAN'):
+      shutil.rmtree(work)
+    else:
+      print('build directory kept in ' + work)
+
+  write_results(output, results)
+  if update:
+    write_results(BASELINE, results)
+
+  if not os.path.exists(BASELINE):
+    print('no baseline, record one with run.py -u')
+    return 1
+  baseline = read_results(BASELINE)
+
+  print('%-12s %10s %8s %7s %7s' % ('kernel', 'cycles', 'bytes', 'cyc%',
+                                    'bytes%'))
+  for name in sorted(results):
+    cycles, size = results[name]
+    line = '%-12s %10d %8d' % (name, cycles, size)
+    if name in baseline:
+      base_cycles, base_size = baseline[name]
+      dc = 100.0 * (cycles - base_cycles) / max(base_cycles, 1)
+      ds = 100.0 * (size - base_size) / max(base_size, 1)
+      line += ' %+7.2f %+7.2f' % (dc, ds)
+      if dc > threshold or ds > threshold:
+        line += '  REGRESSION'
+        failed = True
+    else:
+      line += '  not in the baseline, record it with run.py -u'
+      failed = True
+    print(line)
+  return failed and 1 or 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
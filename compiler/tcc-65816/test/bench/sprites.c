@@ -0,0 +1,64 @@
+/* sprite update loop: move 128 sprites and build the OAM shadow table */
+#include <string.h>
+#include "bench.h"
+
+#define SPRITES 128
+
+struct sprite {
+  int x, y;
+  int dx, dy;
+  unsigned char tile, attr;
+};
+
+struct sprite sprites[SPRITES];
+unsigned char oam[512 + 32];
+
+void update_sprites(void)
+{
+  struct sprite *s;
+  unsigned char *o = oam;
+  int i;
+
+  memset(oam + 512, 0, 32);
+  for (i = 0; i < SPRITES; i++) {
+    s = &sprites[i];
+    s->x += s->dx;
+    s->y += s->dy;
+    if (s->x < -16 || s->x > 256)
+      s->dx = -s->dx;
+    if (s->y < -16 || s->y > 224)
+      s->dy = -s->dy;
+    o[0] = s->x;
+    o[1] = s->y;
+    o[2] = s->tile;
+    o[3] = s->attr;
+    o += 4;
+    /* 9th bit of x in the high table */
+    if (s->x & 0x100)
+      oam[512 + (i >> 2)] |= 1 << ((i & 3) << 1);
+  }
+}
+
+int main(void)
+{
+  int i, frame, sum;
+
+  for (i = 0; i < SPRITES; i++) {
+    sprites[i].x = (i * 37) & 255;
+    sprites[i].y = (i * 23) % 224;
+    sprites[i].dx = (i & 3) - 2;
+    sprites[i].dy = ((i >> 2) & 3) - 1;
+    sprites[i].tile = i;
+    sprites[i].attr = 0x30 | ((i & 7) << 1);
+  }
+
+  BENCH_START();
+  for (frame = 0; frame < 8; frame++)
+    update_sprites();
+  BENCH_STOP();
+
+  sum = 0;
+  for (i = 0; i < 512 + 32; i++)
+    sum += oam[i];
+  return sum == 0;
+}
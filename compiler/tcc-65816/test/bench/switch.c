@@ -0,0 +1,84 @@
+/* switch dispatch: a small stack machine interpreter */
+#include "bench.h"
+
+enum { OP_PUSH, OP_ADD, OP_SUB, OP_DUP, OP_OVER, OP_SWAP, OP_DEC, OP_JNZ,
+       OP_DROP, OP_HALT };
+
+/* sum = 0; for (n = 200; n; n--) sum += n; */
+const unsigned char program[] = {
+  OP_PUSH, 0,   /* sum */
+  OP_PUSH, 200, /* sum n */
+  OP_SWAP,      /* 4: n sum */
+  OP_OVER,      /* n sum n */
+  OP_ADD,       /* n sum */
+  OP_SWAP,      /* sum n */
+  OP_DEC,       /* sum n */
+  OP_DUP,       /* sum n n */
+  OP_JNZ, 4,    /* sum n */
+  OP_DROP,      /* sum */
+  OP_HALT
+};
+
+int stack[16];
+
+int run(const unsigned char *prog)
+{
+  const unsigned char *pc = prog;
+  int *sp = stack;
+  int t;
+
+  for (;;) {
+    switch (*pc++) {
+      case OP_PUSH:
+        *sp++ = *pc++;
+        break;
+      case OP_ADD:
+        sp--;
+        sp[-1] += *sp;
+        break;
+      case OP_SUB:
+        sp--;
+        sp[-1] -= *sp;
+        break;
+      case OP_DUP:
+        *sp = sp[-1];
+        sp++;
+        break;
+      case OP_OVER:
+        *sp = sp[-2];
+        sp++;
+        break;
+      case OP_SWAP:
+        t = sp[-1];
+        sp[-1] = sp[-2];
+        sp[-2] = t;
+        break;
+      case OP_DEC:
+        sp[-1]--;
+        break;
+      case OP_JNZ:
+        if (*--sp)
+          pc = prog + *pc;
+        else
+          pc++;
+        break;
+      case OP_DROP:
+        sp--;
+        break;
+      case OP_HALT:
+        return sp[-1];
+    }
+  }
+}
+
+int main(void)
+{
+  int i, sum = 0;
+
+  BENCH_START();
+  for (i = 0; i < 4; i++)
+    sum = run(program);
+  BENCH_STOP();
+
+  return sum != 20100;
+}
@@ -0,0 +1,43 @@
+/* tilemap fill: compute a 32x32 map, then scroll it by one column */
+#include "bench.h"
+
+unsigned int map[32 * 32];
+
+void fill_map(unsigned int base, unsigned char palette)
+{
+  unsigned int *p = map;
+  int x, y;
+
+  for (y = 0; y < 32; y++)
+    for (x = 0; x < 32; x++)
+      *p++ = ((base + x + (y << 5)) & 0x3ff) | (palette << 10) |
+             ((y & 1) << 14);
+}
+
+void scroll_map(void)
+{
+  unsigned int first;
+  int x, y;
+
+  for (y = 0; y < 32; y++) {
+    first = map[y * 32];
+    for (x = 0; x < 31; x++)
+      map[y * 32 + x] = map[y * 32 + x + 1];
+    map[y * 32 + 31] = first;
+  }
+}
+
+int main(void)
+{
+  int i;
+
+  BENCH_START();
+  for (i = 0; i < 4; i++) {
+    fill_map(i * 16, i & 7);
+    scroll_map();
+  }
+  BENCH_STOP();
+
+  /* row 0 after the last fill (base 48, palette 3) and one scroll */
+  return map[0] != (49 | (3 << 10)) || map[31] != (48 | (3 << 10));
+}
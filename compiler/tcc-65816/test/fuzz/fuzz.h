@@ -0,0 +1,53 @@
+/* Support code for the random programs written by gen.py.
+
+   The programs are built for the host, to get the reference checksum,
+   and for the 65816, where int is 16 bits and long long is 32 bits. The
+   types below have the same size on both, and all arithmetic goes through
+   the macros, which work on unsigned values (no overflow) and check
+   divisors and shift counts, so both builds compute the same values. */
+#ifndef FUZZ_H
+#define FUZZ_H
+
+typedef signed char i8;
+typedef unsigned char u8;
+typedef short i16;
+typedef unsigned short u16;
+
+#ifdef __65816__
+typedef long long i32;
+typedef unsigned long long u32;
+/* the build passes the host checksum as CHECKSUM; snesim reports the
+   exit code */
+#define FUZZ_RESULT(c) return (c) != CHECKSUM
+#else
+#include <stdio.h>
+typedef int i32;
+typedef unsigned int u32;
+#define FUZZ_RESULT(c) printf("%lu\n", (unsigned long)(c)); return 0
+#endif
+
+/* operands as unsigned values of at least 16 (32) bits; the caller
+   converts the result back to the type it wants */
+#define W16(a) ((unsigned)(u16)(a))
+#define W32(a) ((u32)(a))
+
+#define DIV16(a, b) (W16(b) ? W16(a) / W16(b) : W16(a))
+#define MOD16(a, b) (W16(b) ? W16(a) % W16(b) : W16(a))
+#define DIV32(a, b) (W32(b) ? W32(a) / W32(b) : W32(a))
+#define MOD32(a, b) (W32(b) ? W32(a) % W32(b) : W32(a))
+
+#define SDIV16(a, b) (((i16)(b) == 0 || ((i16)(a) == -32767 - 1 && (i16)(b) == -1) ? (i16)(a) : (i16)(a) / (i16)(b)))
+#define SMOD16(a, b) (((i16)(b) == 0 || (i16)(b) == -1 ? (i16)(a) : (i16)(a) % (i16)(b)))
+#define SDIV32(a, b) (((i32)(b) == 0 || ((i32)(a) == -2147483647 - 1 && (i32)(b) == -1) ? (i32)(a) : (i32)(a) / (i32)(b)))
+#define SMOD32(a, b) (((i32)(b) == 0 || (i32)(b) == -1 ? (i32)(a) : (i32)(a) % (i32)(b)))
+
+#define SHL16(a, b) (W16(a) << ((b) & 15))
+#define SHR16(a, b) (W16(a) >> ((b) & 15))
+#define SAR16(a, b) ((i16)(a) >> ((b) & 15))
+#define SHL32(a, b) (W32(a) << ((b) & 31))
+#define SHR32(a, b) (W32(a) >> ((b) & 31))
+#define SAR32(a, b) ((i32)(a) >> ((b) & 31))
+
+#define CRC(c, v) ((c) = (c) * 31 + W32(v))
+
+#endif
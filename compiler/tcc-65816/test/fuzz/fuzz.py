@@ -0,0 +1,233 @@
+#!/usr/bin/env python
+# Differential fuzzing of 816-tcc and 816-opt.py.
+#
+# Random programs from gen.py are built for the host, which gives the
+# reference checksum, and with 816-tcc, with and without 816-opt.py, and
+# run under tools/snesim. The 65816 builds get the host checksum as
+# CHECKSUM and fail when they compute something else. Failing programs are
+# kept in the failures directory, along with a reduced version that fails
+# in the same way: lines are removed for as long as the host build still
+# works and the 65816 builds give the same results.
+#
+# usage: fuzz.py [-n count] [-s seed] [-R] [-o dir] [file...]
+#   -n count  number of programs to try (100)
+#   -s seed   seed of the first program (random)
+#   -R        don't reduce failing programs
+#   -o dir    directory for failing programs (failures)
+#   file...   check and reduce these programs instead of generated ones
+#
+# Tools can be overridden from the environment like in test/bench/run.py:
+# TCC, OPT, PYTHON, AS, LD, SNESIM, INCLUDE, HDR and LIBDIR, and HOSTCC
+# and HOSTCFLAGS for the reference build. NOCLEAN=1 keeps the build
+# directory.
+
+from __future__ import print_function
+import getopt
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+
+here = os.path.dirname(os.path.abspath(__file__))
+top = os.path.join(here, '..', '..', '..', '..')
+sys.path.insert(0, here)
+import gen
+
+
+def tool(name, default):
+  return os.environ.get(name, default)
+
+
+TCC = tool('TCC', os.path.join(here, '..', '..', '816-tcc'))
+OPT = tool('OPT', os.path.join(here, '..', '..', '816-opt.py'))
+PYTHON = tool('PYTHON', 'python')
+AS = tool('AS', 'wla-65816')
+LD = tool('LD', 'wlalink')
+SNESIM = tool('SNESIM', 'snesim')
+INCLUDE = tool('INCLUDE', os.path.join(top, 'devkitsnes', 'include'))
+HDR = tool('HDR', os.path.join(top, 'devkitsnes', 'include', 'hdr.asm'))
+LIBDIR = tool('LIBDIR', os.path.join(top, 'pvsneslib', 'lib'))
+LIBS = ['crt0_snes.obj', 'libm.obj', 'libtcc.obj', 'libc.obj']
+HOSTCC = tool('HOSTCC', 'cc')
+HOSTCFLAGS = tool('HOSTCFLAGS', '-O1 -w').split()
+
+# the generated programs run for well under a second of snes time
+MAX_CYCLES = 200000000
+
+# lines the reduction leaves alone: without them, the program would not
+# be valid anymore, or would not report anything
+KEEP = ('#include', 'return ', 'FUZZ_RESULT')
+
+
+def run(cmd, cwd, stdout=None):
+  p = subprocess.Popen(cmd, cwd=cwd, stdout=stdout or subprocess.PIPE,
+                       stderr=subprocess.STDOUT)
+  out = p.communicate()[0]
+  return p.returncode, out and out.decode('latin-1') or ''
+
+
+# reference checksum from the host build, None if it doesn't build
+def host_checksum(src, work):
+  open(os.path.join(work, 'fuzz.c'), 'w').write(src)
+  if run([HOSTCC] + HOSTCFLAGS + ['-I' + here, '-o', 'host', 'fuzz.c'],
+         work)[0]:
+    return None
+  ret, out = run([os.path.join(work, 'host')], work)
+  if ret or not out.strip().isdigit():
+    return None
+  return out.strip()
+
+
+# outcome of the 65816 build: PASS or FAIL as reported by snesim, or the
+# step that went wrong
+def target(src, checksum, optimize, work):
+  open(os.path.join(work, 'fuzz.c'), 'w').write(src)
+  if run([TCC, '-I' + INCLUDE, '-I' + here, '-DSTACK_SIZE=0x2000',
+          '-DCHECKSUM=' + checksum, '-o', 'fuzz.ps', '-c', 'fuzz.c'],
+         work)[0]:
+    return 'NOCOMPILE'
+  if optimize:
+    env = os.environ.copy()
+    env['OPT816_QUIET'] = '1'
+    out = open(os.path.join(work, 'fuzz.asm'), 'w')
+    p = subprocess.Popen([PYTHON, OPT, 'fuzz.ps'], cwd=work, stdout=out,
+                         env=env)
+    p.communicate()
+    out.close()
+    if p.returncode:
+      return 'NOOPT'
+  else:
+    shutil.copy(os.path.join(work, 'fuzz.ps'), os.path.join(work, 'fuzz.asm'))
+  if run([AS, '-io', 'fuzz.asm', 'fuzz.obj'], work)[0]:
+    return 'NOASM'
+  if run([LD, '-dsnov', 'fuzz.obj'] + [os.path.join(LIBDIR, l) for l in LIBS] +
+         ['fuzz.sfc'], work)[0]:
+    return 'NOLINK'
+  out = run([SNESIM, '-c%d' % MAX_CYCLES, 'fuzz.sfc'], work)[1].split()
+  return out and out[0] or 'CRASH'
+
+
+# (plain, optimized) outcomes, None if the host build fails
+def check(src, work):
+  checksum = host_checksum(src, work)
+  if checksum is None:
+    return None
+  return target(src, checksum, False, work), target(src, checksum, True, work)
+
+
+def indent(line):
+  return len(line) - len(line.lstrip())
+
+
+# index of the line closing the block opened at line i (for if/else, the
+# end of the else part), None if there is none
+def block_end(lines, i):
+  for j in range(i + 1, len(lines)):
+    if lines[j].strip().startswith('}') and indent(lines[j]) == indent(lines[i]):
+      if lines[j].strip() != '} else {':
+        return j
+  return None
+
+
+# remove whole blocks (statements with their bodies, and functions), then
+# chunks of lines and single lines, while the program keeps failing the
+# same way
+def reduce(src, outcome, work):
+  lines = src.split('\n')
+  while True:
+    size = len(lines)
+    i = 0
+    while i < len(lines):
+      end = lines[i].endswith('{') and block_end(lines, i)
+      start = i
+      if lines[i] == '{':
+        start = i - 1	# function header
+      if end:
+        cand = lines[:start] + lines[end + 1:]
+        if not [l for l in lines[start:end + 1] if 'FUZZ_RESULT' in l] and \
+           check('\n'.join(cand), work) == outcome:
+          lines = cand
+          i = start
+          continue
+      i += 1
+
+    chunk = len(lines) // 2
+    while chunk >= 1:
+      i = 0
+      progress = False
+      while i < len(lines):
+        part = lines[i:i + chunk]
+        if [l for l in part if l.strip().startswith(KEEP)]:
+          i += chunk
+          continue
+        cand = lines[:i] + lines[i + chunk:]
+        if check('\n'.join(cand), work) == outcome:
+          lines = cand
+          progress = True
+        else:
+          i += chunk
+      if not progress:
+        chunk //= 2
+    if len(lines) == size:
+      return '\n'.join(lines)
+
+
+def report(name, src, outcome, outdir, reducing, work):
+  print('%s: plain %s, optimized %s' % (name, outcome[0], outcome[1]))
+  if not os.path.isdir(outdir):
+    os.makedirs(outdir)
+  open(os.path.join(outdir, name + '.c'), 'w').write(src)
+  if reducing:
+    small = reduce(src, outcome, work)
+    open(os.path.join(outdir, name + '-reduced.c'), 'w').write(small)
+    print('%s: reduced from %d to %d lines' % (name, len(src.split('\n')),
+                                                len(small.split('\n'))))
+
+
+def main():
+  count = 100
+  seed = random.randrange(1 << 30)
+  reducing = True
+  outdir = os.path.join(here, 'failures')
+  opts, args = getopt.getopt(sys.argv[1:], 'n:s:Ro:')
+  for o, a in opts:
+    if o == '-n':
+      count = int(a)
+    elif o == '-s':
+      seed = int(a)
+    elif o == '-R':
+      reducing = False
+    elif o == '-o':
+      outdir = a
+
+  work = tempfile.mkdtemp(prefix='fuzz')
+  shutil.copy(HDR, os.path.join(work, 'hdr.asm'))
+  failed = 0
+  try:
+    if args:
+      cases = [(os.path.splitext(os.path.basename(f))[0], open(f).read())
+               for f in args]
+    else:
+      cases = (('seed%d' % s, gen.Gen(s).program())
+               for s in range(seed, seed + count))
+    for name, src in cases:
+      outcome = check(src, work)
+      if outcome is None:
+        print('%s: host build failed' % name)
+      elif outcome != ('PASS', 'PASS'):
+        report(name, src, outcome, outdir, reducing, work)
+        failed += 1
+  finally:
+    if not os.environ.get('NOCLEAN'):
+      shutil.rmtree(work)
+    else:
+      print('build directory kept in ' + work)
+
+  print('%d failing programs' % failed)
+  return failed and 1 or 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
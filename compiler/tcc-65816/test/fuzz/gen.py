@@ -0,0 +1,281 @@
+#!/usr/bin/env python
+# Random C program generator for differential testing of 816-tcc.
+#
+# The programs only use what 816-tcc supports (no floats, no bitfields, no
+# varargs) and have no undefined behaviour, so the host build and the 65816
+# build must print/return the same checksum: all arithmetic goes through
+# the macros in fuzz.h, array indices are masked, loops have constant trip
+# counts and functions only call functions defined before them.
+#
+# Every statement is on a line of its own, and every line can be removed
+# without introducing undefined behaviour (variables are initialized where
+# they are declared), which is what the line based reduction in fuzz.py
+# relies on.
+#
+# usage: gen.py [-s seed] [-o file]
+
+from __future__ import print_function
+import getopt
+import random
+import sys
+
+TYPES = ['i8', 'u8', 'i16', 'u16', 'i32', 'u32']
+WIDTH = {'i8': 8, 'u8': 8, 'i16': 16, 'u16': 16, 'i32': 32, 'u32': 32}
+ARRAY_SIZE = 8
+
+MAX_DEPTH = 3	# expression nesting
+MAX_NEST = 2	# statement nesting
+MAX_STMTS = 6	# statements per block
+MAX_FUNCS = 5
+MAX_TRIPS = 6	# loop iterations
+
+
+class Gen:
+  def __init__(self, seed):
+    self.rnd = random.Random(seed)
+    self.out = []
+    self.globals = []	# (name, type)
+    self.arrays = []
+    self.fields = []	# struct S members
+    self.pointers = []	# (name, type), pointing to a global
+    self.funcs = []	# (name, return type, parameter types)
+    self.locals = []
+    self.counters = []	# loop counters in scope
+
+  def choice(self, l):
+    return self.rnd.choice(l)
+
+  def chance(self, p):
+    return self.rnd.random() < p
+
+  # a constant of type t
+  def const(self, t):
+    w = WIDTH[t]
+    if self.chance(0.3):
+      v = self.choice([0, 1, 2, 3, 7, 8, 15, 16, 31, (1 << (w - 1)) - 1,
+                       1 << (w - 1), (1 << w) - 1, 0x55, 0xaa, 0xff, 0x100])
+    else:
+      v = self.rnd.getrandbits(w)
+    v &= (1 << w) - 1
+    if t[0] == 'i' and v >> (w - 1):
+      v -= 1 << w
+    if abs(v) > 32767:
+      if v < 0:
+        return '(%s)-0x%x' % (t, -v)
+      return '(%s)0x%x' % (t, v)
+    return '(%s)%d' % (t, v)
+
+  # an lvalue of type t, or of any type if t is None; returns (text, type).
+  # With simple, no array elements (their index would be unsequenced
+  # against the side effects of a call on the right hand side).
+  def lvalue(self, t=None, simple=False):
+    cands = []
+    for n, vt in self.globals + self.locals:
+      cands += [(n, vt)]
+    for n, vt in self.arrays:
+      if not simple:
+        cands += [('%s[W16(%s) & %d]' % (n, '%s', ARRAY_SIZE - 1), vt)]
+    for n, vt in self.fields:
+      cands += [('s%d.%s' % (self.rnd.randrange(2), n), vt)]
+    for n, vt in self.pointers:
+      cands += [('*' + n, vt)]
+    if t:
+      cands = [c for c in cands if c[1] == t] or cands
+    text, vt = self.choice(cands)
+    if '%s' in text:
+      text = text % self.expr(1)[0]
+    return text, vt
+
+  # a side effect free expression; returns (text, type)
+  def expr(self, depth=0):
+    if depth >= MAX_DEPTH or self.chance(0.3):
+      if self.chance(0.25):
+        t = self.choice(TYPES)
+        return self.const(t), t
+      if self.counters and self.chance(0.2):
+        return self.choice(self.counters), 'i16'
+      return self.lvalue()
+
+    k = self.rnd.randrange(10)
+    a, ta = self.expr(depth + 1)
+    if k == 0:
+      # unary
+      t = self.choice(TYPES)
+      w = WIDTH[t] > 16 and '32' or '16'
+      op = self.choice(['-', '~'])
+      if op == '-':
+        return '(%s)(W%s(0) - W%s(%s))' % (t, w, w, a), t
+      return '(%s)~W%s(%s)' % (t, w, a), t
+    if k == 1:
+      return '!(%s)' % a, 'i16'
+    if k == 2:
+      # conversion
+      t = self.choice(TYPES)
+      return '(%s)(%s)' % (t, a), t
+    b, tb = self.expr(depth + 1)
+    if k == 3:
+      t = self.choice(TYPES)
+      op = self.choice(['<', '<=', '>', '>=', '==', '!='])
+      return '((%s)(%s) %s (%s)(%s))' % (t, a, op, t, b), 'i16'
+    if k == 4:
+      op = self.choice(['&&', '||'])
+      return '((%s) %s (%s))' % (a, op, b), 'i16'
+    if k == 5:
+      c = self.expr(depth + 1)[0]
+      t = self.choice(TYPES)
+      return '((%s) ? (%s)(%s) : (%s)(%s))' % (c, t, a, t, b), t
+    t = self.choice(TYPES)
+    w = WIDTH[t] > 16 and '32' or '16'
+    if k == 6:
+      op = self.choice(['DIV', 'MOD', 'SDIV', 'SMOD'])
+      return '(%s)%s%s(%s, %s)' % (t, op, w, a, b), t
+    if k == 7:
+      op = self.choice(['SHL', 'SHR', 'SAR'])
+      if self.chance(0.5):
+        b = str(self.rnd.randrange(int(w)))
+      return '(%s)%s%s(%s, %s)' % (t, op, w, a, b), t
+    op = self.choice(['+', '-', '*', '&', '|', '^'])
+    return '(%s)(W%s(%s) %s W%s(%s))' % (t, w, a, op, w, b), t
+
+  def emit(self, indent, line):
+    self.out.append('  ' * indent + line)
+
+  def assign(self, indent):
+    lv, t = self.lvalue()
+    k = self.rnd.randrange(8)
+    if k == 0 and t[0] == 'u':
+      self.emit(indent, '(%s)%s;' % (lv, self.choice(['++', '--'])))
+    elif k == 1:
+      # compound assignment
+      w = WIDTH[t] > 16 and '32' or '16'
+      op = self.choice(['+', '-', '*', '&', '|', '^'])
+      self.emit(indent, '%s = (%s)(W%s(%s) %s W%s(%s));' %
+                (lv, t, w, lv, op, w, self.expr(1)[0]))
+    else:
+      self.emit(indent, '%s = (%s)(%s);' % (lv, t, self.expr()[0]))
+
+  def call(self, indent, callable):
+    name, rt, params = self.choice(callable)
+    args = ', '.join(['(%s)(%s)' % (p, self.expr(1)[0]) for p in params])
+    if self.chance(0.7):
+      lv, t = self.lvalue(simple=True)
+      self.emit(indent, '%s = (%s)%s(%s);' % (lv, t, name, args))
+    else:
+      self.emit(indent, '%s(%s);' % (name, args))
+
+  def block(self, indent, nest, callable):
+    for n in range(self.rnd.randint(1, MAX_STMTS)):
+      k = self.rnd.randrange(10)
+      if k < 1 and nest < MAX_NEST:
+        self.emit(indent, 'if (%s) {' % self.expr()[0])
+        self.block(indent + 1, nest + 1, callable)
+        if self.chance(0.5):
+          self.emit(indent, '} else {')
+          self.block(indent + 1, nest + 1, callable)
+        self.emit(indent, '}')
+      elif k < 2 and nest < MAX_NEST and len(self.counters) < MAX_NEST:
+        c = 'c%d' % len(self.counters)
+        self.emit(indent, 'for (%s = 0; %s < %d; %s++) {' %
+                  (c, c, self.rnd.randint(1, MAX_TRIPS), c))
+        self.counters.append(c)
+        # no calls in loops, that keeps the run time in check
+        self.block(indent + 1, nest + 1, [])
+        self.counters.pop()
+        self.emit(indent, '}')
+      elif k < 3 and nest < MAX_NEST:
+        self.emit(indent, 'switch (W16(%s) & 3) {' % self.expr()[0])
+        for v in range(4):
+          if self.chance(0.8):
+            self.emit(indent, 'case %d:' % v)
+            self.block(indent + 1, nest + 1, callable)
+            if self.chance(0.8):
+              self.emit(indent + 1, 'break;')
+        self.emit(indent, '}')
+      elif k < 5 and callable:
+        self.call(indent, callable)
+      else:
+        self.assign(indent)
+
+  def function(self, name, rt, params, decls=[]):
+    self.locals = [('p%d' % i, t) for i, t in enumerate(params)]
+    args = ', '.join(['%s p%d' % (t, i) for i, t in enumerate(params)])
+    self.emit(0, '%s %s(%s)' % (rt, name, args or 'void'))
+    self.emit(0, '{')
+    self.emit(1, 'i16 c0 = 0;')
+    self.emit(1, 'i16 c1 = 0;')
+    for i in range(self.rnd.randint(0, 4)):
+      t = self.choice(TYPES)
+      self.emit(1, '%s l%d = %s;' % (t, i, self.const(t)))
+      self.locals.append(('l%d' % i, t))
+    for d in decls:
+      self.emit(1, d)
+    self.block(1, 0, self.funcs)
+
+  def program(self):
+    self.emit(0, '#include "fuzz.h"')
+    self.emit(0, '')
+    for i in range(self.rnd.randint(4, 12)):
+      t = self.choice(TYPES)
+      self.emit(0, '%s g%d = %s;' % (t, i, self.const(t)))
+      self.globals.append(('g%d' % i, t))
+    for i in range(self.rnd.randint(1, 3)):
+      t = self.choice(TYPES)
+      init = ', '.join([self.const(t) for n in range(ARRAY_SIZE)])
+      self.emit(0, '%s a%d[%d] = {%s};' % (t, i, ARRAY_SIZE, init))
+      self.arrays.append(('a%d' % i, t))
+    self.emit(0, 'struct S {')
+    for i in range(self.rnd.randint(1, 4)):
+      t = self.choice(TYPES)
+      self.emit(1, '%s f%d;' % (t, i))
+      self.fields.append(('f%d' % i, t))
+    self.emit(0, '};')
+    for s in range(2):
+      init = ', '.join([self.const(t) for n, t in self.fields])
+      self.emit(0, 'struct S s%d = {%s};' % (s, init))
+    for i in range(self.rnd.randint(0, 3)):
+      n, t = self.choice(self.globals)
+      self.emit(0, '%s *q%d = &%s;' % (t, i, n))
+      self.pointers.append(('q%d' % i, t))
+    self.emit(0, '')
+
+    for i in range(self.rnd.randint(1, MAX_FUNCS)):
+      rt = self.choice(TYPES)
+      params = [self.choice(TYPES) for n in range(self.rnd.randint(0, 3))]
+      self.function('f%d' % i, rt, params)
+      self.emit(1, 'return (%s)(%s);' % (rt, self.expr()[0]))
+      self.emit(0, '}')
+      self.emit(0, '')
+      self.funcs.append(('f%d' % i, rt, params))
+
+    self.function('main', 'int', [], ['u32 crc = 0;'])
+    for n, t in self.globals:
+      self.emit(1, 'CRC(crc, %s);' % n)
+    for n, t in self.arrays:
+      for i in range(ARRAY_SIZE):
+        self.emit(1, 'CRC(crc, %s[%d]);' % (n, i))
+    for s in range(2):
+      for n, t in self.fields:
+        self.emit(1, 'CRC(crc, s%d.%s);' % (s, n))
+    self.emit(1, 'FUZZ_RESULT(crc);')
+    self.emit(0, '}')
+    return '\n'.join(self.out) + '\n'
+
+
+def main():
+  seed = None
+  output = None
+  opts, args = getopt.getopt(sys.argv[1:], 's:o:')
+  for o, a in opts:
+    if o == '-s':
+      seed = int(a)
+    elif o == '-o':
+      output = a
+  src = Gen(seed).program()
+  if output:
+    open(output, 'w').write(src)
+  else:
+    sys.stdout.write(src)
+
+
+if __name__ == '__main__':
+  main()
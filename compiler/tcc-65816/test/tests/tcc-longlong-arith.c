@@ -0,0 +1,95 @@
+/* long long add, subtract and bitwise operations done inline by the
+   code generator, and narrowing of long long to smaller integer types.
+   long long is 32 bits wide on this target. */
+
+typedef unsigned long long ULL;
+typedef long long LL;
+
+struct arith {
+  ULL a, b, add, sub, and, or, xor;
+} tab[] = {
+  { 0x0000ffffULL, 0x00000001ULL, 0x00010000ULL, 0x0000fffeULL, 0x00000001ULL, 0x0000ffffULL, 0x0000fffeULL },
+  { 0x89abcdefULL, 0x7654321fULL, 0x0000000eULL, 0x13579bd0ULL, 0x0000000fULL, 0xffffffffULL, 0xfffffff0ULL },
+  { 0xffffffffULL, 0xffffffffULL, 0xfffffffeULL, 0x00000000ULL, 0xffffffffULL, 0xffffffffULL, 0x00000000ULL },
+  { 0x00010000ULL, 0x0000ffffULL, 0x0001ffffULL, 0x00000001ULL, 0x00000000ULL, 0x0001ffffULL, 0x0001ffffULL },
+  { 0x80000000ULL, 0x00000001ULL, 0x80000001ULL, 0x7fffffffULL, 0x00000000ULL, 0x80000001ULL, 0x80000001ULL },
+};
+
+ULL add(ULL a, ULL b) { return a + b; }
+ULL sub(ULL a, ULL b) { return a - b; }
+ULL and(ULL a, ULL b) { return a & b; }
+ULL or(ULL a, ULL b) { return a | b; }
+ULL xor(ULL a, ULL b) { return a ^ b; }
+
+/* constant operands have their own code: inc/dec for 1 and -1, the high
+   word only for multiples of 65536, stz or nothing for trivial masks */
+struct consts {
+  ULL x, inc, dec, add64k, sub, andhi, orlo;
+} ctab[] = {
+  { 0x0000ffffULL, 0x00010000ULL, 0x0000fffeULL, 0x0001ffffULL, 0xffffdcbaULL, 0x00000000ULL, 0x0000ffffULL },
+  { 0xffffffffULL, 0x00000000ULL, 0xfffffffeULL, 0x0000ffffULL, 0xfffedcbaULL, 0xffff0000ULL, 0xffffffffULL },
+  { 0x89abcdefULL, 0x89abcdf0ULL, 0x89abcdeeULL, 0x89accdefULL, 0x89aaaaaaULL, 0x89ab0000ULL, 0x89abffffULL },
+  { 0x00000000ULL, 0x00000001ULL, 0xffffffffULL, 0x00010000ULL, 0xfffedcbbULL, 0x00000000ULL, 0x0000ffffULL },
+};
+
+ULL inc(ULL x) { return x + 1; }
+ULL dec(ULL x) { return x - 1; }
+ULL add64k(ULL x) { return x + 0x10000; }
+ULL subc(ULL x) { return x - 0x12345; }
+ULL andhi(ULL x) { return x & 0xffff0000ULL; }
+ULL orlo(ULL x) { return x | 0xffff; }
+
+LL g = 0x1234fedcLL;
+
+int to_int(LL x) { return x; }
+short to_short(LL x) { return x; }
+signed char to_char(LL x) { return x; }
+unsigned char to_uchar(ULL x) { return x; }
+
+int main()
+{
+  int i;
+  LL l;
+
+  for (i = 0; i < sizeof(tab) / sizeof(tab[0]); i++) {
+    if (add(tab[i].a, tab[i].b) != tab[i].add)
+      abort();
+    if (sub(tab[i].a, tab[i].b) != tab[i].sub)
+      abort();
+    if (and(tab[i].a, tab[i].b) != tab[i].and)
+      abort();
+    if (or(tab[i].a, tab[i].b) != tab[i].or)
+      abort();
+    if (xor(tab[i].a, tab[i].b) != tab[i].xor)
+      abort();
+  }
+  for (i = 0; i < sizeof(ctab) / sizeof(ctab[0]); i++) {
+    if (inc(ctab[i].x) != ctab[i].inc)
+      abort();
+    if (dec(ctab[i].x) != ctab[i].dec)
+      abort();
+    if (add64k(ctab[i].x) != ctab[i].add64k)
+      abort();
+    if (subc(ctab[i].x) != ctab[i].sub)
+      abort();
+    if (andhi(ctab[i].x) != ctab[i].andhi)
+      abort();
+    if (orlo(ctab[i].x) != ctab[i].orlo)
+      abort();
+  }
+
+  /* narrowing keeps the low word: registers, lvalues and constants */
+  if (to_int(0x12348765LL) != (int)0x8765 || to_short(-2) != -2)
+    abort();
+  if (to_char(0x123456f0LL) != -16 || to_uchar(0x123456f0ULL) != 0xf0)
+    abort();
+  if ((int)g != (int)0xfedc || (signed char)g != (signed char)0xdc ||
+      (unsigned char)g != 0xdc)
+    abort();
+  if ((int)0x1234fedcLL != -292 || (unsigned int)0x1234fedcLL != 0xfedc)
+    abort();
+  l = g + 1;
+  if ((short)l != (short)0xfedd)
+    abort();
+  exit(0);
+}
@@ -0,0 +1,88 @@
+/* long long compares done inline by the code generator, signed and
+   unsigned, against registers and constants. long long is 32 bits wide
+   on this target. */
+
+typedef unsigned long long ULL;
+typedef long long LL;
+
+#define LT 1
+#define LE 2
+#define GT 4
+#define GE 8
+#define EQ 16
+#define NE 32
+
+struct cmp {
+  ULL a, b;
+  int s, u; /* expected signed and unsigned results */
+} tab[] = {
+  { 0x00000000ULL, 0x00000000ULL, 0x1a, 0x1a },
+  { 0x00000001ULL, 0x00000000ULL, 0x2c, 0x2c },
+  { 0x00010000ULL, 0x0000ffffULL, 0x2c, 0x2c },
+  { 0x0000ffffULL, 0x00010000ULL, 0x23, 0x23 },
+  { 0xffffffffULL, 0x00000000ULL, 0x23, 0x2c },
+  { 0x00000000ULL, 0xffffffffULL, 0x2c, 0x23 },
+  { 0x80000000ULL, 0x7fffffffULL, 0x23, 0x2c },
+  { 0x7fffffffULL, 0x80000000ULL, 0x2c, 0x23 },
+  { 0x12340000ULL, 0x12340001ULL, 0x23, 0x23 },
+  { 0x12340001ULL, 0x12340000ULL, 0x2c, 0x2c },
+  { 0xfffffffeULL, 0xffffffffULL, 0x23, 0x23 },
+  { 0x00018000ULL, 0x00017fffULL, 0x2c, 0x2c },
+};
+
+int scmp(LL a, LL b)
+{
+  return (a < b ? LT : 0) | (a <= b ? LE : 0) | (a > b ? GT : 0) |
+         (a >= b ? GE : 0) | (a == b ? EQ : 0) | (a != b ? NE : 0);
+}
+
+int ucmp(ULL a, ULL b)
+{
+  return (a < b ? LT : 0) | (a <= b ? LE : 0) | (a > b ? GT : 0) |
+         (a >= b ? GE : 0) | (a == b ? EQ : 0) | (a != b ? NE : 0);
+}
+
+/* compares with a constant take other paths: 0 only tests the sign or
+   ors the words together */
+int szero(LL a)
+{
+  return (a < 0 ? LT : 0) | (a <= 0 ? LE : 0) | (a > 0 ? GT : 0) |
+         (a >= 0 ? GE : 0) | (a == 0 ? EQ : 0) | (a != 0 ? NE : 0);
+}
+
+int sconst(LL a)
+{
+  return (a < -65536 ? LT : 0) | (a <= -65536 ? LE : 0) |
+         (a > -65536 ? GT : 0) | (a >= -65536 ? GE : 0) |
+         (a == -65536 ? EQ : 0) | (a != -65536 ? NE : 0);
+}
+
+int uconst(ULL a)
+{
+  return (a < 0x10000ULL ? LT : 0) | (a <= 0x10000ULL ? LE : 0) |
+         (a > 0x10000ULL ? GT : 0) | (a >= 0x10000ULL ? GE : 0) |
+         (a == 0x10000ULL ? EQ : 0) | (a != 0x10000ULL ? NE : 0);
+}
+
+int main()
+{
+  int i;
+
+  for (i = 0; i < sizeof(tab) / sizeof(tab[0]); i++) {
+    if (scmp(tab[i].a, tab[i].b) != tab[i].s)
+      abort();
+    if (ucmp(tab[i].a, tab[i].b) != tab[i].u)
+      abort();
+  }
+  if (szero(0) != (LE | GE | EQ) || szero(1) != (GT | GE | NE) ||
+      szero(-1) != (LT | LE | NE) || szero(0x10000LL) != (GT | GE | NE) ||
+      szero(0x80000000LL) != (LT | LE | NE))
+    abort();
+  if (sconst(-65536) != (LE | GE | EQ) || sconst(-65537) != (LT | LE | NE) ||
+      sconst(-65535) != (GT | GE | NE) || sconst(0x10000LL) != (GT | GE | NE))
+    abort();
+  if (uconst(0x10000ULL) != (LE | GE | EQ) || uconst(0xffffULL) != (LT | LE | NE) ||
+      uconst(0xffffffffULL) != (GT | GE | NE) || uconst(0x10001ULL) != (GT | GE | NE))
+    abort();
+  exit(0);
+}
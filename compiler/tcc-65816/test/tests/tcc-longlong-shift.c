@@ -0,0 +1,103 @@
+/* long long shifts done inline by the code generator: constant counts
+   below 8, from 8 to 15 and from 16 up, and variable counts. long long
+   is 32 bits wide on this target. */
+
+typedef unsigned long long ULL;
+typedef long long LL;
+
+struct shift {
+  ULL x;
+  int n;
+  ULL shl, shr, sar;
+} tab[] = {
+  { 0x89abcdefULL,  1, 0x13579bdeULL, 0x44d5e6f7ULL, 0xc4d5e6f7ULL },
+  { 0x89abcdefULL,  3, 0x4d5e6f78ULL, 0x113579bdULL, 0xf13579bdULL },
+  { 0x89abcdefULL,  7, 0xd5e6f780ULL, 0x0113579bULL, 0xff13579bULL },
+  { 0x89abcdefULL,  8, 0xabcdef00ULL, 0x0089abcdULL, 0xff89abcdULL },
+  { 0x89abcdefULL,  9, 0x579bde00ULL, 0x0044d5e6ULL, 0xffc4d5e6ULL },
+  { 0x89abcdefULL, 12, 0xbcdef000ULL, 0x00089abcULL, 0xfff89abcULL },
+  { 0x89abcdefULL, 15, 0xe6f78000ULL, 0x00011357ULL, 0xffff1357ULL },
+  { 0x89abcdefULL, 16, 0xcdef0000ULL, 0x000089abULL, 0xffff89abULL },
+  { 0x89abcdefULL, 17, 0x9bde0000ULL, 0x000044d5ULL, 0xffffc4d5ULL },
+  { 0x89abcdefULL, 20, 0xdef00000ULL, 0x0000089aULL, 0xfffff89aULL },
+  { 0x89abcdefULL, 31, 0x80000000ULL, 0x00000001ULL, 0xffffffffULL },
+  { 0x7654321fULL,  1, 0xeca8643eULL, 0x3b2a190fULL, 0x3b2a190fULL },
+  { 0x7654321fULL,  3, 0xb2a190f8ULL, 0x0eca8643ULL, 0x0eca8643ULL },
+  { 0x7654321fULL,  7, 0x2a190f80ULL, 0x00eca864ULL, 0x00eca864ULL },
+  { 0x7654321fULL,  8, 0x54321f00ULL, 0x00765432ULL, 0x00765432ULL },
+  { 0x7654321fULL,  9, 0xa8643e00ULL, 0x003b2a19ULL, 0x003b2a19ULL },
+  { 0x7654321fULL, 12, 0x4321f000ULL, 0x00076543ULL, 0x00076543ULL },
+  { 0x7654321fULL, 15, 0x190f8000ULL, 0x0000eca8ULL, 0x0000eca8ULL },
+  { 0x7654321fULL, 16, 0x321f0000ULL, 0x00007654ULL, 0x00007654ULL },
+  { 0x7654321fULL, 17, 0x643e0000ULL, 0x00003b2aULL, 0x00003b2aULL },
+  { 0x7654321fULL, 20, 0x21f00000ULL, 0x00000765ULL, 0x00000765ULL },
+  { 0x7654321fULL, 31, 0x80000000ULL, 0x00000000ULL, 0x00000000ULL },
+};
+
+#define CONST_SHIFTS(n) \
+  ULL shl##n(ULL x) { return x << n; } \
+  ULL shr##n(ULL x) { return x >> n; } \
+  LL sar##n(LL x) { return x >> n; }
+
+CONST_SHIFTS(1)
+CONST_SHIFTS(3)
+CONST_SHIFTS(7)
+CONST_SHIFTS(8)
+CONST_SHIFTS(9)
+CONST_SHIFTS(12)
+CONST_SHIFTS(15)
+CONST_SHIFTS(16)
+CONST_SHIFTS(17)
+CONST_SHIFTS(20)
+CONST_SHIFTS(31)
+
+struct {
+  int n;
+  ULL (*shl)(ULL);
+  ULL (*shr)(ULL);
+  LL (*sar)(LL);
+} consts[] = {
+  {  1, shl1, shr1, sar1 },
+  {  3, shl3, shr3, sar3 },
+  {  7, shl7, shr7, sar7 },
+  {  8, shl8, shr8, sar8 },
+  {  9, shl9, shr9, sar9 },
+  { 12, shl12, shr12, sar12 },
+  { 15, shl15, shr15, sar15 },
+  { 16, shl16, shr16, sar16 },
+  { 17, shl17, shr17, sar17 },
+  { 20, shl20, shr20, sar20 },
+  { 31, shl31, shr31, sar31 },
+};
+
+ULL shl(ULL x, int n) { return x << n; }
+ULL shr(ULL x, int n) { return x >> n; }
+LL sar(LL x, int n) { return x >> n; }
+
+int main()
+{
+  int i, j;
+  struct shift *t;
+
+  for (i = 0; i < sizeof(tab) / sizeof(tab[0]); i++) {
+    t = &tab[i];
+    if (shl(t->x, t->n) != t->shl)
+      abort();
+    if (shr(t->x, t->n) != t->shr)
+      abort();
+    if (sar(t->x, t->n) != (LL)t->sar)
+      abort();
+    for (j = 0; consts[j].n != t->n; j++)
+      ;
+    if (consts[j].shl(t->x) != t->shl)
+      abort();
+    if (consts[j].shr(t->x) != t->shr)
+      abort();
+    if (consts[j].sar(t->x) != (LL)t->sar)
+      abort();
+  }
+  /* a count of 0 leaves the value alone */
+  if (shl(0x89abcdefULL, 0) != 0x89abcdefULL || sar(-2, 0) != -2)
+    abort();
+  exit(0);
+}
@@ -0,0 +1,100 @@
+/* bit manipulation on variables in .bss, which 816-opt.py turns into
+   tsb/trb, and single-bit tests it turns into bit and a branch on N or V.
+   The functions returning the result of the assignment, or testing it,
+   need the value in the accu afterwards and have to be left alone. */
+
+unsigned int flags;
+unsigned char bflags;
+
+/* tsb/trb */
+int set4(void) { flags |= 4; return 0; }
+int clr4(void) { flags &= ~4; return 0; }
+int bset(void) { bflags |= 0x21; return 0; }
+int bclr(void) { bflags &= ~0x21; return 0; }
+
+/* bit: the top bit goes to N, the one below it to V */
+int top(void) { if (flags & 0x8000) return 1; return 0; }
+int ntop(void) { if (!(flags & 0x8000)) return 1; return 0; }
+int next(void) { if (flags & 0x4000) return 1; return 0; }
+int mid(void) { if (flags & 0x10) return 1; return 0; }
+int btop(void) { if (bflags & 0x80) return 1; return 0; }
+int bnext(void) { if (bflags & 0x40) return 1; return 0; }
+int nbnext(void) { if (!(bflags & 0x40)) return 1; return 0; }
+int either(void) { return (flags & 0x8000) || (flags & 0x4000); }
+unsigned int norm(void) { while (!(flags & 0x8000)) flags <<= 1; return flags; }
+
+/* the result is used: no rewrite */
+int setval(void) { unsigned int v = (flags |= 8); return v; }
+int setflags(void) { if (flags |= 8) return 1; return 0; }
+int setand(void) { if ((flags |= 8) & 1) return 1; return 0; }
+int bsetflags(void) { if (bflags |= 8) return 1; return 0; }
+int bsetval(void) { unsigned char v = (bflags |= 0x21); return v; }
+int keep(void) { unsigned int v; if ((v = flags & 0x8000)) return v >> 8; return 2; }
+int bkeep(void) { unsigned char v; if ((v = bflags & 0x80)) return v; return 2; }
+
+int main(void)
+{
+  flags = 0x1230;
+  set4();
+  if (flags != 0x1234) abort();
+  set4();
+  if (flags != 0x1234) abort();
+  clr4();
+  if (flags != 0x1230) abort();
+  clr4();
+  if (flags != 0x1230) abort();
+
+  bflags = 0x90;
+  bset();
+  if (bflags != 0xb1) abort();
+  bclr();
+  if (bflags != 0x90) abort();
+  /* the byte ops must not touch the next byte */
+  if (flags != 0x1230) abort();
+
+  if (top() || !ntop() || next() || !mid()) abort();
+  flags = 0x8000;
+  if (!top() || ntop() || next() || mid()) abort();
+  flags = 0x4000;
+  if (top() || !ntop() || !next() || mid()) abort();
+  flags = 0x00c0;
+  if (top() || next() || mid()) abort();
+
+  flags = 0x8000;
+  if (!either()) abort();
+  flags = 0x4000;
+  if (!either()) abort();
+  flags = 0x3fff;
+  if (either()) abort();
+  flags = 0x0030;
+  if (norm() != 0xc000) abort();
+
+  bflags = 0x80;
+  if (!btop() || bnext() || !nbnext()) abort();
+  bflags = 0x40;
+  if (btop() || !bnext() || nbnext()) abort();
+  bflags = 0x3f;
+  if (btop() || bnext() || !nbnext()) abort();
+
+  flags = 0x1001;
+  if (setval() != 0x1009 || flags != 0x1009) abort();
+  flags = 0;
+  if (!setflags() || flags != 8) abort();
+  flags = 1;
+  if (!setand() || flags != 9) abort();
+  flags = 2;
+  if (setand() || flags != 10) abort();
+  bflags = 0;
+  if (!bsetflags() || bflags != 8) abort();
+  bflags = 0x40;
+  if (bsetval() != 0x61 || bflags != 0x61) abort();
+  flags = 0x8100;
+  if (keep() != 0x80) abort();
+  flags = 0x7fff;
+  if (keep() != 2) abort();
+  bflags = 0xc0;
+  if (bkeep() != 0x80) abort();
+  bflags = 0x7f;
+  if (bkeep() != 2) abort();
+  exit(0);
+}
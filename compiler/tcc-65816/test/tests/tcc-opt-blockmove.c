@@ -0,0 +1,157 @@
+/* copy and fill loops, which 816-opt.py replaces with mvn. A fill copies
+   the first period of the pattern over the rest, with the destination
+   overlapping the source. Loops running zero times or once, and ones
+   leaving gaps between the elements they store, are left as they are.
+   Either way, the counter has its final value after the loop. */
+
+unsigned char src[40], bytes[44];
+int words[24];
+
+int copy(void)
+{
+  unsigned int i;
+
+  for (i = 0; i < 40; i++)
+    bytes[i + 2] = src[i];
+  return i;
+}
+
+int fill_byte(void)
+{
+  unsigned int i;
+
+  for (i = 2; i < 42; i++)
+    bytes[i] = 0x5a;
+  return i;
+}
+
+int fill_word(void)
+{
+  unsigned int i;
+
+  for (i = 2; i < 22; i++)
+    words[i] = 0x1234;
+  return i;
+}
+
+int fill_pair(void)
+{
+  unsigned int i;
+
+  for (i = 1; i < 11; i++) {
+    words[2 * i] = -2;
+    words[2 * i + 1] = 7;
+  }
+  return i;
+}
+
+int fill_step(void)
+{
+  int si;
+
+  for (si = 0; si < 38; si += 3)
+    bytes[si + 2] = 0xa5;
+  return si;
+}
+
+int fill_step2(void)
+{
+  unsigned int i;
+
+  for (i = 0; i < 21; i += 2) {
+    bytes[i + 2] = 1;
+    bytes[i + 3] = 2;
+  }
+  return i;
+}
+
+int none(void)
+{
+  unsigned int i;
+
+  for (i = 5; i < 5; i++)
+    bytes[i] = 1;
+  return i;
+}
+
+int once(void)
+{
+  unsigned int i;
+
+  for (i = 5; i < 6; i++)
+    bytes[i] = 1;
+  return i;
+}
+
+void clear(void)
+{
+  int n;
+  for (n = 0; n < 44; n++)
+    bytes[n] = 0xee;
+  for (n = 0; n < 24; n++)
+    words[n] = 0x7777;
+}
+
+int main(void)
+{
+  int n;
+
+  for (n = 0; n < 40; n++)
+    src[n] = n * 7 + 1;
+  clear();
+  if (copy() != 40)
+    abort();
+  for (n = 0; n < 40; n++)
+    if (bytes[n + 2] != (unsigned char)(n * 7 + 1))
+      abort();
+  if (bytes[0] != 0xee || bytes[1] != 0xee || bytes[42] != 0xee || bytes[43] != 0xee)
+    abort();
+
+  clear();
+  if (fill_byte() != 42)
+    abort();
+  for (n = 0; n < 44; n++)
+    if (bytes[n] != (n < 2 || n >= 42 ? 0xee : 0x5a))
+      abort();
+
+  clear();
+  if (fill_word() != 22)
+    abort();
+  for (n = 0; n < 24; n++)
+    if (words[n] != (n < 2 || n >= 22 ? 0x7777 : 0x1234))
+      abort();
+
+  clear();
+  if (fill_pair() != 11)
+    abort();
+  for (n = 0; n < 24; n++)
+    if (words[n] != (n < 2 || n >= 22 ? 0x7777 : n & 1 ? 7 : -2))
+      abort();
+
+  clear();
+  if (fill_step() != 39)
+    abort();
+  for (n = 0; n < 44; n++)
+    if (bytes[n] != (n >= 2 && n < 40 && (n - 2) % 3 == 0 ? 0xa5 : 0xee))
+      abort();
+
+  clear();
+  if (fill_step2() != 22)
+    abort();
+  for (n = 0; n < 44; n++)
+    if (bytes[n] != (n < 2 || n >= 24 ? 0xee : n & 1 ? 2 : 1))
+      abort();
+
+  clear();
+  if (none() != 5)
+    abort();
+  for (n = 0; n < 44; n++)
+    if (bytes[n] != 0xee)
+      abort();
+  if (once() != 6)
+    abort();
+  for (n = 0; n < 44; n++)
+    if (bytes[n] != (n == 5 ? 1 : 0xee))
+      abort();
+  exit(0);
+}
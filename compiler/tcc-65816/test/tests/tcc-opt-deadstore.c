@@ -0,0 +1,60 @@
+/* stores to pseudo-registers that 816-opt.py has to keep: a value that is
+   read along one edge of a branch only (the switch keeps its value in r0
+   for the next compare, the case bodies overwrite it), and values held in
+   pseudo-registers across calls of the libtcc helpers, which only clobber
+   some of them. */
+
+typedef long long LL;
+typedef unsigned long long ULL;
+
+int sw(int a, int b)
+{
+  switch (a + b) {
+  case 1: return 10;
+  case 5: return 20;
+  case 9: return 30;
+  }
+  return 0;
+}
+
+/* tcc__mul, tcc__mull */
+int mul(int a, int b, int c, int d) { return a * b + c * d; }
+LL mull(LL a, LL b, LL c) { return a * b + c * a; }
+/* tcc__udiv, tcc__div */
+unsigned int udiv(unsigned int a, unsigned int b, unsigned int c) { return a / b + a % c; }
+int sdiv(int a, int b, int c) { return a / b - a % c; }
+/* tcc__divdi3, tcc__moddi3, tcc__udivdi3, tcc__umoddi3 */
+LL divdi(LL a, LL b, LL c) { return a / b + a % c; }
+ULL udivdi(ULL a, ULL b, ULL c) { return a / b + a % c; }
+/* tcc__jsl_r10, tcc__jsl_ind_r9 */
+int twice(int a) { return a * 2; }
+int (*fp)(int);
+int callp(int a) { return fp(a) + fp(a + 1); }
+struct s { int (*f)(int); } s, *ps;
+int calls(int a) { return ps->f(a) - a; }
+
+int main(void)
+{
+  if (sw(0, 1) != 10 || sw(2, 3) != 20 || sw(4, 5) != 30 || sw(3, 3) != 0)
+    abort();
+  if (mul(3, 5, 7, 11) != 92 || mul(-3, 5, 7, -11) != -92)
+    abort();
+  if (mull(100000LL, 3, 7) != 1000000LL || mull(-2, 65536LL, 5) != -131082LL)
+    abort();
+  if (udiv(50000U, 7, 1000) != 7142 || udiv(65535U, 255, 256) != 512)
+    abort();
+  if (sdiv(-1000, 7, 300) != -42 || sdiv(1000, -7, 300) != -242)
+    abort();
+  if (divdi(1000000LL, 7, 1000) != 142857LL || divdi(-1000000LL, 7, 300) != -142957LL)
+    abort();
+  if (udivdi(4000000000ULL, 3, 7) != 1333333336ULL)
+    abort();
+  fp = twice;
+  if (callp(10) != 42)
+    abort();
+  s.f = twice;
+  ps = &s;
+  if (calls(21) != 21)
+    abort();
+  exit(0);
+}
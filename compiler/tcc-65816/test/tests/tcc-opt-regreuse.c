@@ -0,0 +1,60 @@
+/* values 816-opt.py assumes the accu, X or Y hold at the start of a block,
+   where one of the paths leading there changes the register: a call of a
+   libtcc helper (tcc__div hands the remainder back in X), a compare
+   leaving its result in X, or the low word difference of a long long
+   compare kept in Y by tay and read back by tya further down. -1LL is
+   0LL decremented, which tests the low word for the borrow with bne after
+   loading it: the flags of that load are live, so it has to stay even
+   where the accu holds 0 already. */
+
+typedef long long LL;
+typedef unsigned long long ULL;
+
+int n, m;
+
+int divq(int a, int c) { int q = 7 / a; if (c) n = 7; return q; }
+int divr(int a, int c) { int r = 7 % a; if (c) n = 7; else m = 7; return r; }
+int div2(int a, int c) { int q = 7 / a; if (c) q += 100 / c; n = 7; return q; }
+
+int eqx(int r, int c, int d) { if (c) r += d == 3; return r + 1; }
+int ltx(int r, int c, int d) { if (c) r += d < 3; else r -= d > 3; return r + 1; }
+
+int cmpll(LL a, LL b) { if (a == b) return 1; if (a < b) return 2; if (a > b) return 3; return 4; }
+int cmpull(ULL a, ULL b) { return (a <= b) + 2 * (a >= b); }
+
+LL minus1(void) { n = 0; return -1LL; }
+LL minus1c(int c) { n = 0; if (c) return -1LL; return 0; }
+LL dec0(unsigned int x) { if (x == 0) return x - 1LL; return x; }
+
+int main(void)
+{
+  n = m = 0;
+  if (divq(2, 0) != 3 || n != 0 || divq(2, 1) != 3 || n != 7)
+    abort();
+  n = m = 0;
+  if (divr(3, 1) != 1 || n != 7 || m != 0 || divr(4, 0) != 3 || m != 7)
+    abort();
+  n = 0;
+  if (div2(3, 7) != 16 || n != 7 || div2(-3, 0) != -2)
+    abort();
+
+  if (eqx(5, 0, 3) != 6 || eqx(5, 1, 3) != 7 || eqx(5, 1, 4) != 6)
+    abort();
+  if (ltx(5, 1, 2) != 7 || ltx(5, 1, 3) != 6 || ltx(5, 0, 4) != 5 || ltx(5, 0, 3) != 6)
+    abort();
+
+  if (cmpll(0x10000LL, 0x10000LL) != 1 || cmpll(0x10000LL, 0x20000LL) != 2 ||
+      cmpll(0x20000LL, 0x10000LL) != 3 || cmpll(0x10001LL, 0x10000LL) != 3 ||
+      cmpll(-1LL, 0LL) != 2 || cmpll(0x1ffffLL, 0x20000LL) != 2)
+    abort();
+  if (cmpull(0x10000ULL, 0x10000ULL) != 3 || cmpull(0x10000ULL, 0x1ffffULL) != 1 ||
+      cmpull(0x20000ULL, 0x1ffffULL) != 2 || cmpull(0xffff0000ULL, 0xffffULL) != 2)
+    abort();
+
+  n = 5;
+  if (minus1() != -1LL || n != 0 || minus1c(1) != -1LL || minus1c(0) != 0)
+    abort();
+  if (dec0(0) != -1LL || dec0(5) != 5)
+    abort();
+  exit(0);
+}
@@ -26,6 +26,7 @@ tcc__f3h dsb 2
 move_insn dsb 4	; 3 bytes mvn + 1 byte rts
 move_backwards_insn dsb 4 ; 3 bytes mvp + 1 byte rts
 __nmi_handler dsb 4
+tcc__frame dsb 2	; vblank count, timestamps the -pg profile samples
 
 tcc__registers_irq dsb 0
 tcc__regs_irq dsb 48
@@ -198,6 +199,7 @@ VBlank:
   pea $7e7e
   plb
   plb
+  inc.w tcc__frame
   lda.w #tcc__registers_irq
   tad
   lda.l __nmi_handler
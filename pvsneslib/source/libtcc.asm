@@ -348,3 +348,74 @@ tcc__jsl_ind_r9:
 
 .ends
 
+
+; profiling hooks, called on entry to and exit from every function compiled
+; with -pg. Each call stores an 8 byte sample in tcc__prof_ring:
+;   +0  24 bit return address, i.e. where in the function the hook was called
+;   +3  0 on entry, 1 on exit
+;   +4  scanline (V counter)
+;   +6  vblank count (tcc__frame)
+; tcc__prof_pos is the offset of the next sample. tools/snesprof turns a
+; dump of WRAM into a profile.
+.ramsection ".profile" bank $7e slot 2
+tcc__prof_pos dsb 2
+tcc__prof_ring dsb 4096
+.ends
+
+.section ".profile_hooks" superfree
+
+.accu 16
+.index 16
+
+tcc__prof_enter:
+      php
+      sei
+      rep #$30
+      pha
+      lda.w #0
+      bra tcc__prof_sample
+
+tcc__prof_exit:
+      php
+      sei
+      rep #$30
+      pha
+      lda.w #$0100
+
+tcc__prof_sample:
+      phx
+      pha                       ; kind, in the high byte
+      ; claim a slot first, so a sample taken in the NMI handler does not
+      ; overwrite this one
+      lda.l tcc__prof_pos
+      tax
+      clc
+      adc.w #8
+      and.w #4095
+      sta.l tcc__prof_pos
+      ; stack: kind, x, a, p, return address
+      lda 8,s
+      sta.l tcc__prof_ring,x
+      lda 10,s
+      and.w #$00ff
+      ora 1,s
+      sta.l tcc__prof_ring + 2,x
+      sep #$20
+      lda.l $2137               ; latch the H/V counters
+      lda.l $213f               ; reset the OPHCT/OPVCT flip-flops
+      lda.l $213d               ; scanline, low byte
+      xba
+      lda.l $213d               ; scanline, bit 8
+      and.b #$01
+      xba
+      rep #$20
+      sta.l tcc__prof_ring + 4,x
+      lda.l tcc__frame
+      sta.l tcc__prof_ring + 6,x
+      pla
+      plx
+      pla
+      plp
+      rtl
+
+.ends
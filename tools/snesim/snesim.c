@@ -0,0 +1,1321 @@
+/***************************************************************************
+
+  snesim.c
+
+  Headless 65816 simulator for snes.
+  Runs a LoROM image until it stops (stp) and reports the exit code
+  written to $fffd by the runtime (see crt0_snes.asm), like the patched
+  bsnes used by the tcc test suite. Only the hardware the runtime and
+  the tests touch is simulated: WRAM and its port, the multiplier and
+  divider, general purpose DMA (to a sink, or to WRAM through $2180),
+  the H/V counters and the vblank NMI. Cycle counts use the datasheet
+  base timings, plus the 16 bit and direct page penalties.
+  Writing non zero to $fffc starts the benchmark timer and writing zero
+  stops it; the cycles counted in between are reported as "bench=".
+
+***************************************************************************/
+
+// INCLUDES
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// DEFINES
+#define FLAG_C 0x01
+#define FLAG_Z 0x02
+#define FLAG_I 0x04
+#define FLAG_D 0x08
+#define FLAG_X 0x10
+#define FLAG_M 0x20
+#define FLAG_V 0x40
+#define FLAG_N 0x80
+
+#define MASTER_PER_CYCLE 8  // slowrom timing
+#define MASTER_PER_LINE 1364
+#define LINES_PER_FRAME 262
+#define VBLANK_LINE 225
+
+#define EXIT_ADDR 0xfffd
+#define BENCH_ADDR 0xfffc
+#define DEFAULT_MAX_CYCLES 2000000000ULL
+
+// addressing modes
+enum {
+  AM_DP,
+  AM_DPX,
+  AM_DPY,
+  AM_DPI,
+  AM_DPIL,
+  AM_DPXI,
+  AM_DPIY,
+  AM_DPILY,
+  AM_ABS,
+  AM_ABSX,
+  AM_ABSY,
+  AM_LONG,
+  AM_LONGX,
+  AM_SR,
+  AM_SRIY,
+  AM_IMM
+};
+
+// base cycles of each opcode, 8 bit registers, direct page aligned
+static const unsigned char cycles_table[256] = {
+    8, 6, 8, 4, 5, 3, 5, 6, 3, 2, 2, 4, 6, 4, 6, 5,  // 00
+    2, 5, 5, 7, 5, 4, 6, 6, 2, 4, 2, 2, 6, 4, 7, 5,  // 10
+    6, 6, 8, 4, 3, 3, 5, 6, 4, 2, 2, 5, 4, 4, 6, 5,  // 20
+    2, 5, 5, 7, 4, 4, 6, 6, 2, 4, 2, 2, 4, 4, 7, 5,  // 30
+    7, 6, 2, 4, 0, 3, 5, 6, 3, 2, 2, 3, 3, 4, 6, 5,  // 40
+    2, 5, 5, 7, 0, 4, 6, 6, 2, 4, 3, 2, 4, 4, 7, 5,  // 50
+    6, 6, 6, 4, 3, 3, 5, 6, 4, 2, 2, 6, 5, 4, 6, 5,  // 60
+    2, 5, 5, 7, 4, 4, 6, 6, 2, 4, 4, 2, 6, 4, 7, 5,  // 70
+    2, 6, 4, 4, 3, 3, 3, 6, 2, 2, 2, 3, 4, 4, 4, 5,  // 80
+    2, 6, 5, 7, 4, 4, 4, 6, 2, 5, 2, 2, 4, 5, 5, 5,  // 90
+    2, 6, 2, 4, 3, 3, 3, 6, 2, 2, 2, 4, 4, 4, 4, 5,  // a0
+    2, 5, 5, 7, 4, 4, 4, 6, 2, 4, 2, 2, 4, 4, 4, 5,  // b0
+    2, 6, 3, 4, 3, 3, 5, 6, 2, 2, 2, 3, 4, 4, 6, 5,  // c0
+    2, 5, 5, 7, 6, 4, 6, 6, 2, 4, 3, 3, 6, 4, 7, 5,  // d0
+    2, 6, 3, 4, 3, 3, 5, 6, 2, 2, 2, 3, 4, 4, 6, 5,  // e0
+    2, 5, 5, 7, 5, 4, 6, 6, 2, 4, 4, 2, 8, 4, 7, 5,  // f0
+};
+
+// addressing mode of the ORA/AND/EOR/ADC/STA/LDA/CMP/SBC group, by the
+// low 5 bits of the opcode (-1: not in the group)
+static const signed char alu_modes[32] = {
+    -1,      AM_DPXI, -1,     AM_SR,    -1, AM_DP,   -1, AM_DPIL,
+    -1,      AM_IMM,  -1,     -1,       -1, AM_ABS,  -1, AM_LONG,
+    -1,      AM_DPIY, AM_DPI, AM_SRIY,  -1, AM_DPX,  -1, AM_DPILY,
+    -1,      AM_ABSY, -1,     -1,       -1, AM_ABSX, -1, AM_LONGX,
+};
+
+// b-bus register offsets for each dma transfer mode
+static const unsigned char dma_pattern[8][4] = {
+    {0, 0, 0, 0}, {0, 1, 0, 1}, {0, 0, 0, 0}, {0, 0, 1, 1},
+    {0, 1, 2, 3}, {0, 1, 0, 1}, {0, 0, 0, 0}, {0, 0, 1, 1},
+};
+
+//// M A I N   V A R I A B L E S
+///////////////////////////////////////////////////
+int quietmode = 0;  // 0 = not quiet, 1 = i can't say anything :P
+int tracemode = 0;  // 1 = print every instruction on stderr
+unsigned long long maxcycles = DEFAULT_MAX_CYCLES;
+char filebase[256] = "";  // rom filename
+char *wramfile = NULL;     // wram dump written when the run ends
+
+struct {
+  uint16_t a, x, y, s, d, pc;
+  uint8_t db, pb, p, e;
+  int stopped, waiting;
+  unsigned long long cycles;
+} cpu;
+
+unsigned char *rom;
+unsigned int romsize;
+unsigned char wram[0x20000];
+unsigned char sram[0x8000];
+
+unsigned long long master;     // master clock
+unsigned long long nextvblank;  // master clock of the next vblank
+int nmi_pending, nmi_flag;
+int exit_code = -1;  // last byte written to $fffd
+int benching;        // benchmark timer running
+unsigned long long bench_start, bench_cycles;
+
+// io registers
+unsigned int wmaddr;  // wram port address
+unsigned char nmitimen, wrmpya, dma_regs[8][16];
+unsigned int wrdiv, rddiv, rdmpy;
+unsigned int ophct, opvct;
+int ophct_flip, opvct_flip;
+
+int extra;  // cycles added by the current instruction
+
+//// F U N C T I O N S
+/////////////////////////////////////////////////////////////
+
+static void update_counters(void) {
+  unsigned long long pos = master % (MASTER_PER_LINE * LINES_PER_FRAME);
+  ophct = (unsigned int)((pos % MASTER_PER_LINE) / 4);
+  opvct = (unsigned int)(pos / MASTER_PER_LINE);
+}
+
+static unsigned char io_read(unsigned int addr) {
+  unsigned char v;
+
+  if (addr >= 0x4300 && addr < 0x4380)
+    return dma_regs[(addr >> 4) & 7][addr & 15];
+
+  switch (addr) {
+    case 0x2137:  // SLHV
+      update_counters();
+      return 0;
+    case 0x213c:  // OPHCT
+      v = ophct_flip ? (ophct >> 8) & 1 : ophct & 0xff;
+      ophct_flip ^= 1;
+      return v;
+    case 0x213d:  // OPVCT
+      v = opvct_flip ? (opvct >> 8) & 1 : opvct & 0xff;
+      opvct_flip ^= 1;
+      return v;
+    case 0x213f:  // STAT78
+      ophct_flip = opvct_flip = 0;
+      return 0x03;
+    case 0x2180:  // WMDATA
+      v = wram[wmaddr];
+      wmaddr = (wmaddr + 1) & 0x1ffff;
+      return v;
+    case 0x4210:  // RDNMI
+      v = (nmi_flag ? 0x80 : 0) | 0x02;
+      nmi_flag = 0;
+      return v;
+    case 0x4212:  // HVBJOY
+      update_counters();
+      return (opvct >= VBLANK_LINE ? 0x80 : 0) | (ophct >= 274 ? 0x40 : 0);
+    case 0x4214:
+      return rddiv & 0xff;
+    case 0x4215:
+      return rddiv >> 8;
+    case 0x4216:
+      return rdmpy & 0xff;
+    case 0x4217:
+      return rdmpy >> 8;
+  }
+  return 0;  // ppu, apu and joypads: nothing there
+}
+
+static void io_write(unsigned int addr, unsigned char v);
+
+static unsigned char read8(uint32_t addr) {
+  unsigned int bank = addr >> 16, off = addr & 0xffff, b;
+
+  if (bank == 0x7e || bank == 0x7f) return wram[addr - 0x7e0000];
+  b = bank & 0x7f;
+  if (off >= 0x8000) return rom[(b * 0x8000 + off - 0x8000) % romsize];
+  if (b < 0x40) {
+    if (off < 0x2000) return wram[off];
+    return io_read(off);
+  }
+  if (b >= 0x70) return sram[off];
+  return 0;
+}
+
+static void write8(uint32_t addr, unsigned char v) {
+  unsigned int bank = addr >> 16, off = addr & 0xffff, b;
+
+  // exit convention of the runtime, whatever the data bank
+  if (off == EXIT_ADDR && bank != 0x7f) exit_code = v;
+  if (off == BENCH_ADDR && bank != 0x7f) {
+    if (v && !benching) bench_start = cpu.cycles;
+    if (!v && benching) bench_cycles += cpu.cycles - bench_start;
+    benching = v != 0;
+  }
+  if (bank == 0x7e || bank == 0x7f) {
+    wram[addr - 0x7e0000] = v;
+    return;
+  }
+  b = bank & 0x7f;
+  if (off >= 0x8000) return;  // rom
+  if (b < 0x40) {
+    if (off < 0x2000)
+      wram[off] = v;
+    else
+      io_write(off, v);
+  } else if (b >= 0x70) {
+    sram[off] = v;
+  }
+}
+
+static unsigned int read16(uint32_t addr) {
+  return read8(addr) | (read8((addr + 1) & 0xffffff) << 8);
+}
+
+static uint32_t read24(uint32_t addr) {
+  return read16(addr) | (read8((addr + 2) & 0xffffff) << 16);
+}
+
+static void write16(uint32_t addr, unsigned int v) {
+  write8(addr, v & 0xff);
+  write8((addr + 1) & 0xffffff, v >> 8);
+}
+
+static void dma_run(unsigned char channels) {
+  int c, i;
+  unsigned char *r, mode;
+  unsigned int aaddr, count, baddr;
+
+  for (c = 0; c < 8; c++) {
+    if (!(channels & (1 << c))) continue;
+    r = dma_regs[c];
+    mode = r[0] & 7;
+    aaddr = r[2] | (r[3] << 8);
+    count = r[5] | (r[6] << 8);
+    if (!count) count = 0x10000;
+    for (i = 0; count > 0; count--, i++) {
+      baddr = 0x2100 | ((r[1] + dma_pattern[mode][i & 3]) & 0xff);
+      if (r[0] & 0x80)
+        write8((r[4] << 16) | aaddr, io_read(baddr));
+      else
+        io_write(baddr, read8((r[4] << 16) | aaddr));
+      if (!(r[0] & 0x08))
+        aaddr = (r[0] & 0x10 ? aaddr - 1 : aaddr + 1) & 0xffff;
+      master += MASTER_PER_CYCLE;
+    }
+    r[2] = aaddr & 0xff;
+    r[3] = aaddr >> 8;
+    r[5] = r[6] = 0;
+  }
+}
+
+static void io_write(unsigned int addr, unsigned char v) {
+  if (addr >= 0x4300 && addr < 0x4380) {
+    dma_regs[(addr >> 4) & 7][addr & 15] = v;
+    return;
+  }
+
+  switch (addr) {
+    case 0x2180:  // WMDATA
+      wram[wmaddr] = v;
+      wmaddr = (wmaddr + 1) & 0x1ffff;
+      break;
+    case 0x2181:
+      wmaddr = (wmaddr & 0x1ff00) | v;
+      break;
+    case 0x2182:
+      wmaddr = (wmaddr & 0x100ff) | (v << 8);
+      break;
+    case 0x2183:
+      wmaddr = (wmaddr & 0x0ffff) | ((v & 1) << 16);
+      break;
+    case 0x4200:  // NMITIMEN
+      nmitimen = v;
+      break;
+    case 0x4202:  // WRMPYA
+      wrmpya = v;
+      break;
+    case 0x4203:  // WRMPYB
+      rdmpy = wrmpya * v;
+      break;
+    case 0x4204:
+      wrdiv = (wrdiv & 0xff00) | v;
+      break;
+    case 0x4205:
+      wrdiv = (wrdiv & 0x00ff) | (v << 8);
+      break;
+    case 0x4206:  // WRDIVB
+      if (v) {
+        rddiv = wrdiv / v;
+        rdmpy = wrdiv % v;
+      } else {
+        rddiv = 0xffff;
+        rdmpy = wrdiv;
+      }
+      break;
+    case 0x420b:  // MDMAEN
+      dma_run(v);
+      break;
+  }
+}
+
+//// C P U
+/////////////////////////////////////////////////////////////////////
+
+static int m16(void) { return !(cpu.p & FLAG_M); }
+static int x16(void) { return !(cpu.p & FLAG_X); }
+
+static unsigned int fetch8(void) {
+  unsigned int v = read8((cpu.pb << 16) | cpu.pc);
+  cpu.pc++;
+  return v;
+}
+
+static unsigned int fetch16(void) {
+  unsigned int v = fetch8();
+  return v | (fetch8() << 8);
+}
+
+static uint32_t fetch24(void) {
+  uint32_t v = fetch16();
+  return v | (fetch8() << 16);
+}
+
+static void push8(unsigned int v) {
+  write8(cpu.s, v);
+  cpu.s--;
+  if (cpu.e) cpu.s = 0x100 | (cpu.s & 0xff);
+}
+
+static void push16(unsigned int v) {
+  push8(v >> 8);
+  push8(v & 0xff);
+}
+
+static unsigned int pull8(void) {
+  cpu.s++;
+  if (cpu.e) cpu.s = 0x100 | (cpu.s & 0xff);
+  return read8(cpu.s);
+}
+
+static unsigned int pull16(void) {
+  unsigned int v = pull8();
+  return v | (pull8() << 8);
+}
+
+// enforce the register widths after a change of P or E
+static void fix_widths(void) {
+  if (cpu.e) {
+    cpu.p |= FLAG_M | FLAG_X;
+    cpu.s = 0x100 | (cpu.s & 0xff);
+  }
+  if (cpu.p & FLAG_X) {
+    cpu.x &= 0xff;
+    cpu.y &= 0xff;
+  }
+}
+
+static void set_nz(unsigned int v, int wide) {
+  cpu.p &= ~(FLAG_N | FLAG_Z);
+  if (wide) {
+    if (!(v & 0xffff)) cpu.p |= FLAG_Z;
+    if (v & 0x8000) cpu.p |= FLAG_N;
+  } else {
+    if (!(v & 0xff)) cpu.p |= FLAG_Z;
+    if (v & 0x80) cpu.p |= FLAG_N;
+  }
+}
+
+static unsigned int get_a(void) { return m16() ? cpu.a : cpu.a & 0xff; }
+
+static void set_a(unsigned int v) {
+  if (m16())
+    cpu.a = v & 0xffff;
+  else
+    cpu.a = (cpu.a & 0xff00) | (v & 0xff);
+  set_nz(v, m16());
+}
+
+static void set_index(uint16_t *r, unsigned int v) {
+  *r = x16() ? v & 0xffff : v & 0xff;
+  set_nz(v, x16());
+}
+
+static unsigned int direct(unsigned int off) {
+  if (cpu.d & 0xff) extra++;
+  return (cpu.d + off) & 0xffff;
+}
+
+// effective address of a memory operand
+static uint32_t ea(int mode) {
+  uint32_t t;
+
+  switch (mode) {
+    case AM_DP:
+      return direct(fetch8());
+    case AM_DPX:
+      return direct(fetch8() + cpu.x);
+    case AM_DPY:
+      return direct(fetch8() + cpu.y);
+    case AM_DPI:
+      return (cpu.db << 16) | read16(direct(fetch8()));
+    case AM_DPIL:
+      return read24(direct(fetch8()));
+    case AM_DPXI:
+      return (cpu.db << 16) | read16(direct(fetch8() + cpu.x));
+    case AM_DPIY:
+      t = (cpu.db << 16) | read16(direct(fetch8()));
+      if (x16()) extra++;
+      return (t + cpu.y) & 0xffffff;
+    case AM_DPILY:
+      return (read24(direct(fetch8())) + cpu.y) & 0xffffff;
+    case AM_ABS:
+      return (cpu.db << 16) | fetch16();
+    case AM_ABSX:
+      t = (cpu.db << 16) | fetch16();
+      if (x16()) extra++;
+      return (t + cpu.x) & 0xffffff;
+    case AM_ABSY:
+      t = (cpu.db << 16) | fetch16();
+      if (x16()) extra++;
+      return (t + cpu.y) & 0xffffff;
+    case AM_LONG:
+      return fetch24();
+    case AM_LONGX:
+      return (fetch24() + cpu.x) & 0xffffff;
+    case AM_SR:
+      return (cpu.s + fetch8()) & 0xffff;
+    case AM_SRIY:
+      t = (cpu.db << 16) | read16((cpu.s + fetch8()) & 0xffff);
+      return (t + cpu.y) & 0xffffff;
+  }
+  return 0;
+}
+
+// read an operand of the width of A (wide) or of the index registers
+static unsigned int operand(int mode, int wide) {
+  uint32_t addr;
+
+  if (wide) extra++;
+  if (mode == AM_IMM) return wide ? fetch16() : fetch8();
+  addr = ea(mode);
+  return wide ? read16(addr) : read8(addr);
+}
+
+static void store(int mode, unsigned int v, int wide) {
+  uint32_t addr = ea(mode);
+
+  if (wide) {
+    extra++;
+    write16(addr, v);
+  } else {
+    write8(addr, v);
+  }
+}
+
+// decimal add of 'n' nibbles; 'sub' when 'data' is the complement of a
+// subtrahend
+static unsigned int add_decimal(unsigned int a, unsigned int data, int sub,
+                                int n) {
+  int result = 0, c = cpu.p & FLAG_C, i, shift;
+
+  for (i = 0; i < n; i++) {
+    shift = 4 * i;
+    result = (a & (0xf << shift)) + (data & (0xf << shift)) + (c << shift) +
+             (result & ((1 << shift) - 1));
+    if (i == n - 1) {
+      cpu.p &= ~FLAG_V;
+      if (~(a ^ data) & (a ^ result) & (8 << shift)) cpu.p |= FLAG_V;
+    }
+    if (!sub && result > (10 << shift) - 1) result += 6 << shift;
+    if (sub && result <= (1 << (shift + 4)) - 1) result -= 6 << shift;
+    c = result > (1 << (shift + 4)) - 1;
+  }
+  cpu.p = (cpu.p & ~FLAG_C) | (c ? FLAG_C : 0);
+  return result;
+}
+
+static void adc(unsigned int data, int sub) {
+  unsigned int a = get_a(), result, mask = m16() ? 0xffff : 0xff;
+  unsigned int sign = m16() ? 0x8000 : 0x80;
+
+  if (sub) data = ~data & mask;
+  if (cpu.p & FLAG_D) {
+    result = add_decimal(a, data, sub, m16() ? 4 : 2);
+  } else {
+    result = a + data + (cpu.p & FLAG_C);
+    cpu.p &= ~(FLAG_C | FLAG_V);
+    if (result > mask) cpu.p |= FLAG_C;
+    if (~(a ^ data) & (a ^ result) & sign) cpu.p |= FLAG_V;
+  }
+  set_a(result & mask);
+}
+
+static void compare(unsigned int r, unsigned int v, int wide) {
+  unsigned int mask = wide ? 0xffff : 0xff;
+
+  r &= mask;
+  cpu.p &= ~FLAG_C;
+  if (r >= v) cpu.p |= FLAG_C;
+  set_nz((r - v) & mask, wide);
+}
+
+static void bit(unsigned int v, int imm) {
+  int wide = m16();
+
+  cpu.p &= ~FLAG_Z;
+  if (!(get_a() & v)) cpu.p |= FLAG_Z;
+  if (imm) return;
+  cpu.p &= ~(FLAG_N | FLAG_V);
+  if (v & (wide ? 0x8000 : 0x80)) cpu.p |= FLAG_N;
+  if (v & (wide ? 0x4000 : 0x40)) cpu.p |= FLAG_V;
+}
+
+// read-modify-write operations
+enum { RMW_ASL, RMW_ROL, RMW_LSR, RMW_ROR, RMW_INC, RMW_DEC, RMW_TSB, RMW_TRB };
+
+static unsigned int rmw_op(int op, unsigned int v) {
+  int wide = m16();
+  unsigned int sign = wide ? 0x8000 : 0x80, mask = wide ? 0xffff : 0xff;
+  unsigned int c = cpu.p & FLAG_C;
+
+  switch (op) {
+    case RMW_ASL:
+      cpu.p = (cpu.p & ~FLAG_C) | ((v & sign) ? FLAG_C : 0);
+      v = (v << 1) & mask;
+      break;
+    case RMW_ROL:
+      cpu.p = (cpu.p & ~FLAG_C) | ((v & sign) ? FLAG_C : 0);
+      v = ((v << 1) | c) & mask;
+      break;
+    case RMW_LSR:
+      cpu.p = (cpu.p & ~FLAG_C) | (v & 1);
+      v >>= 1;
+      break;
+    case RMW_ROR:
+      cpu.p = (cpu.p & ~FLAG_C) | (v & 1);
+      v = (v >> 1) | (c ? sign : 0);
+      break;
+    case RMW_INC:
+      v = (v + 1) & mask;
+      break;
+    case RMW_DEC:
+      v = (v - 1) & mask;
+      break;
+    case RMW_TSB:
+    case RMW_TRB:
+      cpu.p &= ~FLAG_Z;
+      if (!(get_a() & v)) cpu.p |= FLAG_Z;
+      return op == RMW_TSB ? v | get_a() : v & ~get_a() & mask;
+  }
+  set_nz(v, wide);
+  return v;
+}
+
+static void rmw(int op, int mode) {
+  uint32_t addr = ea(mode);
+
+  if (m16()) {
+    extra += 2;
+    write16(addr, rmw_op(op, read16(addr)));
+  } else {
+    write8(addr, rmw_op(op, read8(addr)));
+  }
+}
+
+static void branch(int cond) {
+  int off = (signed char)fetch8();
+
+  if (cond) {
+    cpu.pc += off;
+    extra++;
+  }
+}
+
+static void interrupt(unsigned int native_vector, unsigned int emu_vector) {
+  if (!cpu.e) push8(cpu.pb);
+  push16(cpu.pc);
+  push8(cpu.p);
+  cpu.p = (cpu.p | FLAG_I) & ~FLAG_D;
+  cpu.pb = 0;
+  cpu.pc = read16(cpu.e ? emu_vector : native_vector);
+}
+
+static void block_move(int step) {
+  unsigned int dst = fetch8(), src = fetch8();
+
+  cpu.db = dst;
+  do {
+    write8((dst << 16) | cpu.y, read8((src << 16) | cpu.x));
+    cpu.x += step;
+    cpu.y += step;
+    if (!x16()) {
+      cpu.x &= 0xff;
+      cpu.y &= 0xff;
+    }
+    cpu.a--;
+    extra += 7;
+  } while (cpu.a != 0xffff);
+}
+
+static void step(void) {
+  unsigned int op, t;
+  int mode;
+
+  if (tracemode)
+    fprintf(stderr,
+            "%02x:%04x a=%04x x=%04x y=%04x s=%04x d=%04x db=%02x p=%02x%s\n",
+            cpu.pb, cpu.pc, cpu.a, cpu.x, cpu.y, cpu.s, cpu.d, cpu.db, cpu.p,
+            cpu.e ? " e" : "");
+
+  op = fetch8();
+  extra = 0;
+
+  mode = alu_modes[op & 0x1f];
+  if (mode >= 0 && op != 0x89) {
+    switch (op >> 5) {
+      case 0:  // ORA
+        set_a(get_a() | operand(mode, m16()));
+        break;
+      case 1:  // AND
+        set_a(get_a() & operand(mode, m16()));
+        break;
+      case 2:  // EOR
+        set_a(get_a() ^ operand(mode, m16()));
+        break;
+      case 3:  // ADC
+        adc(operand(mode, m16()), 0);
+        break;
+      case 4:  // STA
+        store(mode, cpu.a, m16());
+        break;
+      case 5:  // LDA
+        set_a(operand(mode, m16()));
+        break;
+      case 6:  // CMP
+        compare(cpu.a, operand(mode, m16()), m16());
+        break;
+      case 7:  // SBC
+        adc(operand(mode, m16()), 1);
+        break;
+    }
+    cpu.cycles += cycles_table[op] + extra;
+    return;
+  }
+
+  switch (op) {
+    // stores and loads of the other registers
+    case 0x64:
+      store(AM_DP, 0, m16());
+      break;
+    case 0x74:
+      store(AM_DPX, 0, m16());
+      break;
+    case 0x9c:
+      store(AM_ABS, 0, m16());
+      break;
+    case 0x9e:
+      store(AM_ABSX, 0, m16());
+      break;
+    case 0x86:
+      store(AM_DP, cpu.x, x16());
+      break;
+    case 0x96:
+      store(AM_DPY, cpu.x, x16());
+      break;
+    case 0x8e:
+      store(AM_ABS, cpu.x, x16());
+      break;
+    case 0x84:
+      store(AM_DP, cpu.y, x16());
+      break;
+    case 0x94:
+      store(AM_DPX, cpu.y, x16());
+      break;
+    case 0x8c:
+      store(AM_ABS, cpu.y, x16());
+      break;
+    case 0xa2:
+      set_index(&cpu.x, operand(AM_IMM, x16()));
+      break;
+    case 0xa6:
+      set_index(&cpu.x, operand(AM_DP, x16()));
+      break;
+    case 0xb6:
+      set_index(&cpu.x, operand(AM_DPY, x16()));
+      break;
+    case 0xae:
+      set_index(&cpu.x, operand(AM_ABS, x16()));
+      break;
+    case 0xbe:
+      set_index(&cpu.x, operand(AM_ABSY, x16()));
+      break;
+    case 0xa0:
+      set_index(&cpu.y, operand(AM_IMM, x16()));
+      break;
+    case 0xa4:
+      set_index(&cpu.y, operand(AM_DP, x16()));
+      break;
+    case 0xb4:
+      set_index(&cpu.y, operand(AM_DPX, x16()));
+      break;
+    case 0xac:
+      set_index(&cpu.y, operand(AM_ABS, x16()));
+      break;
+    case 0xbc:
+      set_index(&cpu.y, operand(AM_ABSX, x16()));
+      break;
+    case 0xe0:
+      compare(cpu.x, operand(AM_IMM, x16()), x16());
+      break;
+    case 0xe4:
+      compare(cpu.x, operand(AM_DP, x16()), x16());
+      break;
+    case 0xec:
+      compare(cpu.x, operand(AM_ABS, x16()), x16());
+      break;
+    case 0xc0:
+      compare(cpu.y, operand(AM_IMM, x16()), x16());
+      break;
+    case 0xc4:
+      compare(cpu.y, operand(AM_DP, x16()), x16());
+      break;
+    case 0xcc:
+      compare(cpu.y, operand(AM_ABS, x16()), x16());
+      break;
+
+    // bit tests
+    case 0x89:
+      bit(operand(AM_IMM, m16()), 1);
+      break;
+    case 0x24:
+      bit(operand(AM_DP, m16()), 0);
+      break;
+    case 0x34:
+      bit(operand(AM_DPX, m16()), 0);
+      break;
+    case 0x2c:
+      bit(operand(AM_ABS, m16()), 0);
+      break;
+    case 0x3c:
+      bit(operand(AM_ABSX, m16()), 0);
+      break;
+
+    // read-modify-write
+    case 0x0a:
+      set_a(rmw_op(RMW_ASL, get_a()));
+      break;
+    case 0x06:
+      rmw(RMW_ASL, AM_DP);
+      break;
+    case 0x16:
+      rmw(RMW_ASL, AM_DPX);
+      break;
+    case 0x0e:
+      rmw(RMW_ASL, AM_ABS);
+      break;
+    case 0x1e:
+      rmw(RMW_ASL, AM_ABSX);
+      break;
+    case 0x2a:
+      set_a(rmw_op(RMW_ROL, get_a()));
+      break;
+    case 0x26:
+      rmw(RMW_ROL, AM_DP);
+      break;
+    case 0x36:
+      rmw(RMW_ROL, AM_DPX);
+      break;
+    case 0x2e:
+      rmw(RMW_ROL, AM_ABS);
+      break;
+    case 0x3e:
+      rmw(RMW_ROL, AM_ABSX);
+      break;
+    case 0x4a:
+      set_a(rmw_op(RMW_LSR, get_a()));
+      break;
+    case 0x46:
+      rmw(RMW_LSR, AM_DP);
+      break;
+    case 0x56:
+      rmw(RMW_LSR, AM_DPX);
+      break;
+    case 0x4e:
+      rmw(RMW_LSR, AM_ABS);
+      break;
+    case 0x5e:
+      rmw(RMW_LSR, AM_ABSX);
+      break;
+    case 0x6a:
+      set_a(rmw_op(RMW_ROR, get_a()));
+      break;
+    case 0x66:
+      rmw(RMW_ROR, AM_DP);
+      break;
+    case 0x76:
+      rmw(RMW_ROR, AM_DPX);
+      break;
+    case 0x6e:
+      rmw(RMW_ROR, AM_ABS);
+      break;
+    case 0x7e:
+      rmw(RMW_ROR, AM_ABSX);
+      break;
+    case 0x1a:
+      set_a(rmw_op(RMW_INC, get_a()));
+      break;
+    case 0xe6:
+      rmw(RMW_INC, AM_DP);
+      break;
+    case 0xf6:
+      rmw(RMW_INC, AM_DPX);
+      break;
+    case 0xee:
+      rmw(RMW_INC, AM_ABS);
+      break;
+    case 0xfe:
+      rmw(RMW_INC, AM_ABSX);
+      break;
+    case 0x3a:
+      set_a(rmw_op(RMW_DEC, get_a()));
+      break;
+    case 0xc6:
+      rmw(RMW_DEC, AM_DP);
+      break;
+    case 0xd6:
+      rmw(RMW_DEC, AM_DPX);
+      break;
+    case 0xce:
+      rmw(RMW_DEC, AM_ABS);
+      break;
+    case 0xde:
+      rmw(RMW_DEC, AM_ABSX);
+      break;
+    case 0x04:
+      rmw(RMW_TSB, AM_DP);
+      break;
+    case 0x0c:
+      rmw(RMW_TSB, AM_ABS);
+      break;
+    case 0x14:
+      rmw(RMW_TRB, AM_DP);
+      break;
+    case 0x1c:
+      rmw(RMW_TRB, AM_ABS);
+      break;
+
+    // index registers
+    case 0xe8:
+      set_index(&cpu.x, cpu.x + 1);
+      break;
+    case 0xc8:
+      set_index(&cpu.y, cpu.y + 1);
+      break;
+    case 0xca:
+      set_index(&cpu.x, cpu.x - 1);
+      break;
+    case 0x88:
+      set_index(&cpu.y, cpu.y - 1);
+      break;
+
+    // transfers
+    case 0xaa:  // TAX
+      set_index(&cpu.x, cpu.a);
+      break;
+    case 0xa8:  // TAY
+      set_index(&cpu.y, cpu.a);
+      break;
+    case 0x8a:  // TXA
+      set_a(cpu.x);
+      break;
+    case 0x98:  // TYA
+      set_a(cpu.y);
+      break;
+    case 0x9b:  // TXY
+      set_index(&cpu.y, cpu.x);
+      break;
+    case 0xbb:  // TYX
+      set_index(&cpu.x, cpu.y);
+      break;
+    case 0xba:  // TSX
+      set_index(&cpu.x, cpu.s);
+      break;
+    case 0x9a:                                   // TXS
+      cpu.s = cpu.e ? 0x100 | (cpu.x & 0xff) : cpu.x;
+      break;
+    case 0x1b:  // TCS
+      cpu.s = cpu.e ? 0x100 | (cpu.a & 0xff) : cpu.a;
+      break;
+    case 0x3b:  // TSC
+      cpu.a = cpu.s;
+      set_nz(cpu.a, 1);
+      break;
+    case 0x5b:  // TCD
+      cpu.d = cpu.a;
+      set_nz(cpu.d, 1);
+      break;
+    case 0x7b:  // TDC
+      cpu.a = cpu.d;
+      set_nz(cpu.a, 1);
+      break;
+    case 0xeb:  // XBA
+      cpu.a = (cpu.a >> 8) | (cpu.a << 8);
+      set_nz(cpu.a, 0);
+      break;
+
+    // stack
+    case 0x48:
+      if (m16()) {
+        push16(cpu.a);
+        extra++;
+      } else {
+        push8(cpu.a);
+      }
+      break;
+    case 0xda:
+      if (x16()) {
+        push16(cpu.x);
+        extra++;
+      } else {
+        push8(cpu.x);
+      }
+      break;
+    case 0x5a:
+      if (x16()) {
+        push16(cpu.y);
+        extra++;
+      } else {
+        push8(cpu.y);
+      }
+      break;
+    case 0x68:
+      if (m16()) extra++;
+      set_a(m16() ? pull16() : pull8());
+      break;
+    case 0xfa:
+      if (x16()) extra++;
+      set_index(&cpu.x, x16() ? pull16() : pull8());
+      break;
+    case 0x7a:
+      if (x16()) extra++;
+      set_index(&cpu.y, x16() ? pull16() : pull8());
+      break;
+    case 0x08:
+      push8(cpu.p);
+      break;
+    case 0x28:
+      cpu.p = pull8();
+      fix_widths();
+      break;
+    case 0x8b:
+      push8(cpu.db);
+      break;
+    case 0xab:
+      cpu.db = pull8();
+      set_nz(cpu.db, 0);
+      break;
+    case 0x4b:
+      push8(cpu.pb);
+      break;
+    case 0x0b:
+      push16(cpu.d);
+      break;
+    case 0x2b:
+      cpu.d = pull16();
+      set_nz(cpu.d, 1);
+      break;
+    case 0xf4:  // PEA
+      push16(fetch16());
+      break;
+    case 0xd4:                            // PEI
+      push16(read16(direct(fetch8())));
+      break;
+    case 0x62:  // PER
+      t = fetch16();
+      push16((cpu.pc + t) & 0xffff);
+      break;
+
+    // flags
+    case 0x18:
+      cpu.p &= ~FLAG_C;
+      break;
+    case 0x38:
+      cpu.p |= FLAG_C;
+      break;
+    case 0x58:
+      cpu.p &= ~FLAG_I;
+      break;
+    case 0x78:
+      cpu.p |= FLAG_I;
+      break;
+    case 0xd8:
+      cpu.p &= ~FLAG_D;
+      break;
+    case 0xf8:
+      cpu.p |= FLAG_D;
+      break;
+    case 0xb8:
+      cpu.p &= ~FLAG_V;
+      break;
+    case 0xc2:
+      cpu.p &= ~fetch8();
+      fix_widths();
+      break;
+    case 0xe2:
+      cpu.p |= fetch8();
+      fix_widths();
+      break;
+    case 0xfb:  // XCE
+      t = cpu.p & FLAG_C;
+      cpu.p = (cpu.p & ~FLAG_C) | (cpu.e ? FLAG_C : 0);
+      cpu.e = t != 0;
+      fix_widths();
+      break;
+
+    // branches and jumps
+    case 0x10:
+      branch(!(cpu.p & FLAG_N));
+      break;
+    case 0x30:
+      branch(cpu.p & FLAG_N);
+      break;
+    case 0x50:
+      branch(!(cpu.p & FLAG_V));
+      break;
+    case 0x70:
+      branch(cpu.p & FLAG_V);
+      break;
+    case 0x90:
+      branch(!(cpu.p & FLAG_C));
+      break;
+    case 0xb0:
+      branch(cpu.p & FLAG_C);
+      break;
+    case 0xd0:
+      branch(!(cpu.p & FLAG_Z));
+      break;
+    case 0xf0:
+      branch(cpu.p & FLAG_Z);
+      break;
+    case 0x80:
+      branch(1);
+      break;
+    case 0x82:  // BRL
+      t = fetch16();
+      cpu.pc += t;
+      break;
+    case 0x4c:
+      cpu.pc = fetch16();
+      break;
+    case 0x5c:
+      t = fetch24();
+      cpu.pc = t & 0xffff;
+      cpu.pb = t >> 16;
+      break;
+    case 0x6c:
+      cpu.pc = read16(fetch16());
+      break;
+    case 0x7c:
+      t = fetch16();
+      cpu.pc = read16((cpu.pb << 16) | ((t + cpu.x) & 0xffff));
+      break;
+    case 0xdc:
+      t = read24(fetch16());
+      cpu.pc = t & 0xffff;
+      cpu.pb = t >> 16;
+      break;
+    case 0x20:
+      t = fetch16();
+      push16(cpu.pc - 1);
+      cpu.pc = t;
+      break;
+    case 0xfc:
+      t = fetch16();
+      push16(cpu.pc - 1);
+      cpu.pc = read16((cpu.pb << 16) | ((t + cpu.x) & 0xffff));
+      break;
+    case 0x22:
+      t = fetch24();
+      push8(cpu.pb);
+      push16(cpu.pc - 1);
+      cpu.pc = t & 0xffff;
+      cpu.pb = t >> 16;
+      break;
+    case 0x60:
+      cpu.pc = pull16() + 1;
+      break;
+    case 0x6b:
+      cpu.pc = pull16() + 1;
+      cpu.pb = pull8();
+      break;
+    case 0x40:
+      cpu.p = pull8();
+      fix_widths();
+      cpu.pc = pull16();
+      if (!cpu.e) cpu.pb = pull8();
+      break;
+
+    // block moves
+    case 0x54:
+      block_move(1);
+      break;
+    case 0x44:
+      block_move(-1);
+      break;
+
+    // misc
+    case 0x00:
+      fetch8();
+      interrupt(0xffe6, 0xfffe);
+      break;
+    case 0x02:
+      fetch8();
+      interrupt(0xffe4, 0xfff4);
+      break;
+    case 0x42:  // WDM
+      fetch8();
+      break;
+    case 0xea:  // NOP
+      break;
+    case 0xdb:
+      cpu.stopped = 1;
+      break;
+    case 0xcb:
+      cpu.waiting = 1;
+      break;
+    default:
+      fprintf(stderr, "snesim: unknown opcode %02x at %02x:%04x\n", op, cpu.pb,
+              (cpu.pc - 1) & 0xffff);
+      cpu.stopped = 1;
+      break;
+  }
+  cpu.cycles += cycles_table[op] + extra;
+}
+
+// run until stp or until the cycle budget is exhausted
+static int run(void) {
+  unsigned long long frame = MASTER_PER_LINE * LINES_PER_FRAME;
+
+  nextvblank = VBLANK_LINE * MASTER_PER_LINE;
+  while (!cpu.stopped) {
+    if (cpu.cycles >= maxcycles) return -1;
+    if (cpu.waiting) {
+      if (!(nmitimen & 0x80)) {
+        fprintf(stderr, "snesim: wai with interrupts disabled\n");
+        return -2;
+      }
+      cpu.cycles += (nextvblank - master) / MASTER_PER_CYCLE;
+      master = nextvblank;
+    }
+    if (master >= nextvblank) {
+      nextvblank += frame;
+      nmi_flag = 1;
+      if (nmitimen & 0x80) nmi_pending = 1;
+    }
+    if (nmi_pending) {
+      nmi_pending = 0;
+      cpu.waiting = 0;
+      interrupt(0xffea, 0xfffa);
+    }
+    {
+      unsigned long long before = cpu.cycles;
+      step();
+      master += (cpu.cycles - before) * MASTER_PER_CYCLE;
+    }
+  }
+  return 0;
+}
+
+static void reset(void) {
+  memset(&cpu, 0, sizeof(cpu));
+  cpu.e = 1;
+  cpu.s = 0x1ff;
+  cpu.p = FLAG_M | FLAG_X | FLAG_I;
+  cpu.pc = read16(0xfffc);
+}
+
+void PrintOptions(char *str) {
+  printf("\n\nUsage : snesim [options] romfile ...");
+  printf("\n  where romfile is a LoROM image (.smc or .sfc)");
+
+  if (str[0] != 0) printf("\nThe [%s] parameter is not recognized.", str);
+
+  printf("\n\nOptions are:");
+  printf("\n\n--- Run options ---");
+  printf("\n-c#               Stop after # cycles [%llu]", DEFAULT_MAX_CYCLES);
+  printf("\n-t                Trace every instruction on stderr");
+  printf("\n-wfilename        Dump the 128KB of WRAM to filename at the end");
+  printf("\n\n--- Misc options ---");
+  printf("\n-q                quiet mode");
+  printf("\n");
+
+}  // end of PrintOptions()
+
+/// M A I N ////////////////////////////////////////////////////////////
+
+int main(int argc, char **arg) {
+  int i, ret;
+  long size;
+  FILE *fp;
+
+  // parse the arguments
+  for (i = 1; i < argc; i++) {
+    if (arg[i][0] == '-') {
+      if (arg[i][1] == 'c')  // cycle budget
+      {
+        maxcycles = strtoull(&arg[i][2], NULL, 0);
+        if (!maxcycles) {
+          PrintOptions(arg[i]);
+          return 1;
+        }
+      } else if (arg[i][1] == 't')  // trace
+      {
+        tracemode = 1;
+      } else if (arg[i][1] == 'w')  // wram dump
+      {
+        wramfile = &arg[i][2];
+      } else if (arg[i][1] == 'q')  // quiet mode
+      {
+        quietmode = 1;
+      } else  // invalid option
+      {
+        PrintOptions(arg[i]);
+        return 1;
+      }
+    } else {
+      // its not an option flag, so it must be the filebase
+      if (filebase[0] != 0)  // if already defined... there's a problem
+      {
+        PrintOptions(arg[i]);
+        return 1;
+      } else if (strlen(arg[i]) >= sizeof(filebase)) {
+        printf("\nERROR: Rom filename [%s] is too long", arg[i]);
+        return 1;
+      } else
+        strcpy(filebase, arg[i]);
+    }
+  }
+
+  if (filebase[0] == 0) {
+    printf("\nERROR: You must specify a rom filename.");
+    PrintOptions("");
+    return 1;
+  }
+
+  fp = fopen(filebase, "rb");
+  if (fp == NULL) {
+    printf("\nERROR: Can't open file [%s]", filebase);
+    return 1;
+  }
+  fseek(fp, 0, SEEK_END);
+  size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  // skip a copier header
+  if ((size & 0x3ff) == 0x200) {
+    fseek(fp, 0x200, SEEK_SET);
+    size -= 0x200;
+  }
+  if (size < 0x8000) {
+    printf("\nERROR: [%s] is too small for a LoROM image", filebase);
+    fclose(fp);
+    return 1;
+  }
+  romsize = (unsigned int)size;
+  rom = (unsigned char *)malloc(romsize);
+  if (!rom || fread(rom, 1, romsize, fp) != romsize) {
+    printf("\nERROR: Can't read file [%s]", filebase);
+    fclose(fp);
+    return 1;
+  }
+  fclose(fp);
+
+  reset();
+  ret = run();
+
+  if (wramfile) {
+    fp = fopen(wramfile, "wb");
+    if (fp == NULL || fwrite(wram, 1, sizeof(wram), fp) != sizeof(wram)) {
+      printf("\nERROR: Can't write file [%s]", wramfile);
+      return 1;
+    }
+    fclose(fp);
+  }
+
+  if (ret == -1) {
+    if (!quietmode) printf("TIMEOUT cycles=%llu\n", cpu.cycles);
+    return 254;
+  }
+  if (ret < 0 || exit_code < 0) {
+    if (!quietmode) printf("CRASH cycles=%llu\n", cpu.cycles);
+    return 255;
+  }
+  if (!quietmode) {
+    if (exit_code == 0)
+      printf("PASS cycles=%llu", cpu.cycles);
+    else
+      printf("FAIL (exit code %d) cycles=%llu", exit_code, cpu.cycles);
+    if (bench_cycles) printf(" bench=%llu", bench_cycles);
+    printf("\n");
+  }
+  free(rom);
+  return exit_code;
+}
@@ -0,0 +1,344 @@
+/***************************************************************************
+
+  snesprof.c
+
+  Profile report for snes programs compiled with 816-tcc -pg.
+  Reads the samples the profiling hooks (tcc__prof_enter/tcc__prof_exit
+  in libtcc.asm) left in WRAM, and prints a flat profile and a call graph
+  in scanlines. The WRAM dump can come from tools/snesim (-w option) or
+  from an emulator; the symbol file is the .sym written by wlalink.
+
+***************************************************************************/
+
+// INCLUDES
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// DEFINES
+#define WRAM_SIZE 0x20000
+#define RING_SIZE 4096  // size of tcc__prof_ring
+#define SAMPLE_SIZE 8
+#define LINES_PER_FRAME 262
+#define VBLANK_LINE 225
+#define MAX_DEPTH 256
+
+typedef struct {
+  char name[64];
+  unsigned int addr;
+  unsigned long calls;
+  long long self, total;
+  int active;  // frames of this function on the call stack
+} Function;
+
+typedef struct {
+  int caller, callee;
+  unsigned long calls;
+  long long time;
+} Arc;
+
+typedef struct {
+  int fn;
+  long long start, child;
+} Frame;
+
+//// M A I N   V A R I A B L E S
+///////////////////////////////////////////////////
+long wramoffset = 0;  // position of WRAM in the dump file
+char wramname[256] = "", symname[256] = "";
+
+unsigned char wram[WRAM_SIZE];
+
+Function *funcs;
+int nfuncs;
+Arc *arcs;
+int narcs;
+unsigned int prof_pos = 0xffffffff, prof_ring = 0xffffffff;
+
+Frame stack[MAX_DEPTH];
+int depth;
+
+//// F U N C T I O N S
+/////////////////////////////////////////////////////////////
+
+static int cmp_addr(const void *a, const void *b) {
+  const Function *fa = (const Function *)a, *fb = (const Function *)b;
+  return fa->addr < fb->addr ? -1 : fa->addr > fb->addr;
+}
+
+static int cmp_self(const void *a, const void *b) {
+  const Function *fa = *(const Function **)a, *fb = *(const Function **)b;
+  if (fa->self != fb->self) return fa->self < fb->self ? 1 : -1;
+  return strcmp(fa->name, fb->name);
+}
+
+// WRAM offset of a label, or -1 if it is not in WRAM
+static long wram_offset(unsigned int addr) {
+  unsigned int bank = addr >> 16;
+
+  if (bank == 0x7e || bank == 0x7f) return addr - 0x7e0000;
+  if ((bank & 0x7f) < 0x40 && (addr & 0xffff) < 0x2000) return addr & 0xffff;
+  return -1;
+}
+
+// read the labels of a wlalink symbol file, with or without the colon
+// between bank and address (snes_rules strips it)
+static int read_symbols(char *filename) {
+  FILE *fp;
+  char line[256], name[64];
+  unsigned int bank, addr;
+  int labels = 0, maxfuncs = 0;
+
+  fp = fopen(filename, "r");
+  if (fp == NULL) {
+    printf("\nERROR: Can't open file [%s]", filename);
+    return 0;
+  }
+  while (fgets(line, sizeof(line), fp)) {
+    if (line[0] == '[') {
+      labels = !strncmp(line, "[labels]", 8);
+      continue;
+    }
+    if (!labels || line[0] == ';') continue;
+    if (sscanf(line, "%x:%x %63s", &bank, &addr, name) == 3)
+      addr |= bank << 16;
+    else if (sscanf(line, "%x %63s", &addr, name) != 2)
+      continue;
+
+    if (!strcmp(name, "tcc__prof_pos")) prof_pos = addr;
+    if (!strcmp(name, "tcc__prof_ring")) prof_ring = addr;
+    // code labels, without the local labels of the functions
+    if ((addr & 0xffff) < 0x8000 || (addr >> 16) == 0x7e ||
+        (addr >> 16) == 0x7f || !strncmp(name, "__local_", 8))
+      continue;
+    if (nfuncs == maxfuncs) {
+      maxfuncs = maxfuncs ? maxfuncs * 2 : 256;
+      funcs = (Function *)realloc(funcs, maxfuncs * sizeof(Function));
+    }
+    memset(&funcs[nfuncs], 0, sizeof(Function));
+    strcpy(funcs[nfuncs].name, name);
+    funcs[nfuncs].addr = addr;
+    nfuncs++;
+  }
+  fclose(fp);
+  qsort(funcs, nfuncs, sizeof(Function), cmp_addr);
+  return 1;
+}
+
+// function containing a code address
+static int find_function(unsigned int addr) {
+  int lo = 0, hi = nfuncs - 1, mid, found = -1;
+
+  while (lo <= hi) {
+    mid = (lo + hi) / 2;
+    if (funcs[mid].addr <= addr) {
+      found = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return found;
+}
+
+static void add_arc(int caller, int callee, long long time) {
+  int i;
+
+  for (i = 0; i < narcs; i++)
+    if (arcs[i].caller == caller && arcs[i].callee == callee) break;
+  if (i == narcs) {
+    if (!(narcs & 255))
+      arcs = (Arc *)realloc(arcs, (narcs + 256) * sizeof(Arc));
+    arcs[narcs].caller = caller;
+    arcs[narcs].callee = callee;
+    arcs[narcs].calls = 0;
+    arcs[narcs].time = 0;
+    narcs++;
+  }
+  arcs[i].calls++;
+  arcs[i].time += time;
+}
+
+// leave the innermost active function at time t
+static void pop_frame(long long t) {
+  Frame *f = &stack[--depth];
+  Function *fn = &funcs[f->fn];
+  long long elapsed = t - f->start;
+
+  fn->calls++;
+  fn->self += elapsed - f->child;
+  if (--fn->active == 0) fn->total += elapsed;  // recursion counts once
+  if (depth > 0) {
+    stack[depth - 1].child += elapsed;
+    add_arc(stack[depth - 1].fn, f->fn, elapsed);
+  }
+}
+
+static void process_samples(void) {
+  long pos = wram[prof_pos] | (wram[prof_pos + 1] << 8);
+  long i, j, n = RING_SIZE / SAMPLE_SIZE;
+  long long t, last = 0, offset = 0;
+  unsigned char *s;
+  unsigned int addr, line, frame;
+  int fn, k;
+
+  for (i = 0; i < n; i++) {
+    // oldest sample first
+    s = &wram[prof_ring + (pos + i * SAMPLE_SIZE) % RING_SIZE];
+    for (j = 0; j < SAMPLE_SIZE && !s[j]; j++)
+      ;
+    if (j == SAMPLE_SIZE) continue;  // never written
+
+    addr = s[0] | (s[1] << 8) | (s[2] << 16);
+    line = s[4] | ((s[5] & 1) << 8);
+    frame = s[6] | (s[7] << 8);
+    fn = find_function(addr);
+    if (fn < 0) continue;
+
+    // the vblank count goes up at the start of vblank, not at line 0;
+    // without NMI it does not move and the scanline wraps around
+    t = ((long long)frame - (line >= VBLANK_LINE)) * LINES_PER_FRAME + line;
+    while (t + offset < last) offset += LINES_PER_FRAME;
+    t += offset;
+    last = t;
+
+    if (s[3] == 0) {
+      if (depth == MAX_DEPTH) {
+        printf("\nERROR: calls nested deeper than %d", MAX_DEPTH);
+        return;
+      }
+      stack[depth].fn = fn;
+      stack[depth].start = t;
+      stack[depth].child = 0;
+      depth++;
+      funcs[fn].active++;
+    } else {
+      // ignore exits from calls made before the oldest sample
+      for (k = depth - 1; k >= 0 && stack[k].fn != fn; k--)
+        ;
+      if (k < 0) continue;
+      while (depth > k) pop_frame(t);
+    }
+  }
+  // functions still running when the dump was taken
+  while (depth > 0) pop_frame(last);
+}
+
+static void print_profile(void) {
+  Function **sorted;
+  long long sum = 0;
+  int i, j;
+
+  sorted = (Function **)malloc(nfuncs * sizeof(Function *));
+  for (i = 0; i < nfuncs; i++) {
+    sorted[i] = &funcs[i];
+    sum += funcs[i].self;
+  }
+  qsort(sorted, nfuncs, sizeof(Function *), cmp_self);
+
+  printf("Flat profile, in scanlines:\n\n");
+  printf("  %%self      self     total     calls  function\n");
+  for (i = 0; i < nfuncs; i++)
+    if (sorted[i]->calls)
+      printf("%7.2f %9lld %9lld %9lu  %s\n",
+             sum ? 100.0 * sorted[i]->self / sum : 0.0, sorted[i]->self,
+             sorted[i]->total, sorted[i]->calls, sorted[i]->name);
+
+  printf("\nCall graph, in scanlines:\n");
+  for (i = 0; i < nfuncs; i++) {
+    int caller = sorted[i] - funcs, first = 1;
+    for (j = 0; j < narcs; j++) {
+      if (arcs[j].caller != caller) continue;
+      if (first) printf("\n%s\n", sorted[i]->name);
+      first = 0;
+      printf("  %9lu calls %9lld  %s\n", arcs[j].calls, arcs[j].time,
+             funcs[arcs[j].callee].name);
+    }
+  }
+  free(sorted);
+}
+
+void PrintOptions(char *str) {
+  printf("\n\nUsage : snesprof [options] wramdump symfile ...");
+  printf("\n  where wramdump holds the 128KB of WRAM ($7e0000-$7fffff)");
+  printf("\n  and symfile is the .sym file of the program built with -pg");
+
+  if (str[0] != 0) printf("\nThe [%s] parameter is not recognized.", str);
+
+  printf("\n\nOptions are:");
+  printf("\n\n--- Input options ---");
+  printf("\n-o#               WRAM starts at offset # of the dump");
+  printf("\n                  (save states)");
+  printf("\n");
+
+}  // end of PrintOptions()
+
+/// M A I N ////////////////////////////////////////////////////////////
+
+int main(int argc, char **arg) {
+  int i;
+  long pos, ring;
+  FILE *fp;
+
+  // parse the arguments
+  for (i = 1; i < argc; i++) {
+    if (arg[i][0] == '-') {
+      if (arg[i][1] == 'o')  // wram offset
+      {
+        wramoffset = strtol(&arg[i][2], NULL, 0);
+      } else  // invalid option
+      {
+        PrintOptions(arg[i]);
+        return 1;
+      }
+    } else {
+      // the dump first, then the symbols
+      if (wramname[0] == 0)
+        strcpy(wramname, arg[i]);
+      else if (symname[0] == 0)
+        strcpy(symname, arg[i]);
+      else {
+        PrintOptions(arg[i]);
+        return 1;
+      }
+    }
+  }
+
+  if (symname[0] == 0) {
+    printf("\nERROR: You must specify a WRAM dump and a symbol file.");
+    PrintOptions("");
+    return 1;
+  }
+
+  fp = fopen(wramname, "rb");
+  if (fp == NULL) {
+    printf("\nERROR: Can't open file [%s]", wramname);
+    return 1;
+  }
+  if (fseek(fp, wramoffset, SEEK_SET) ||
+      fread(wram, 1, WRAM_SIZE, fp) != WRAM_SIZE) {
+    printf("\nERROR: [%s] does not hold 128KB of WRAM at offset %ld", wramname,
+           wramoffset);
+    fclose(fp);
+    return 1;
+  }
+  fclose(fp);
+
+  if (!read_symbols(symname)) return 1;
+  pos = prof_pos == 0xffffffff ? -1 : wram_offset(prof_pos);
+  ring = prof_ring == 0xffffffff ? -1 : wram_offset(prof_ring);
+  if (pos < 0 || ring < 0) {
+    printf("\nERROR: no profiling buffer in [%s], was the program built "
+           "with -pg?", symname);
+    return 1;
+  }
+  prof_pos = pos;
+  prof_ring = ring;
+
+  process_samples();
+  print_profile();
+
+  free(funcs);
+  free(arcs);
+  return 0;
+}